@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <functional>
+
+#include "utility/StringFormat.h"
+#include "utility/Format.h"
+
+// Compares StringFormat against FORMAT / FORMAT_TO on log-like messages.
+// Run a release build: ./format-bench [iterations]
+
+static volatile size_t sink = 0;
+
+static void Run(const char* name, size_t iterations, const std::function<size_t(size_t)>& body) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        sink = sink + body(i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    printf("%-32s %8.1f ns/op\n", name, static_cast<double>(elapsed.count()) / iterations);
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::stoul(argv[1]) : 2000000;
+    std::string deviceName = "NVIDIA GeForce GTX 1060 6GB";
+    char buffer[256];
+
+    Run("StringFormat %s", iterations, [&](size_t) {
+        return StringFormat("Used device: %s", deviceName.c_str()).size();
+    });
+    Run("FORMAT %s", iterations, [&](size_t) {
+        return FORMAT("Used device: %s", deviceName).size();
+    });
+    Run("FORMAT_TO %s", iterations, [&](size_t) {
+        return FORMAT_TO(buffer, sizeof(buffer), "Used device: %s", deviceName);
+    });
+
+    Run("StringFormat %u %u", iterations, [&](size_t i) {
+        return StringFormat("Created bindless table for %u textures, %u buffers", static_cast<unsigned>(i), 1024u).size();
+    });
+    Run("FORMAT %u %u", iterations, [&](size_t i) {
+        return FORMAT("Created bindless table for %u textures, %u buffers", static_cast<unsigned>(i), 1024u).size();
+    });
+    Run("FORMAT_TO %u %u", iterations, [&](size_t i) {
+        return FORMAT_TO(buffer, sizeof(buffer), "Created bindless table for %u textures, %u buffers", static_cast<unsigned>(i), 1024u);
+    });
+
+    Run("StringFormat mixed", iterations, [&](size_t i) {
+        return StringFormat("%s scope: %llu allocs, %.2f ms, %d", "command", static_cast<unsigned long long>(i), i * 0.001, -5).size();
+    });
+    Run("FORMAT mixed", iterations, [&](size_t i) {
+        return FORMAT("%s scope: %llu allocs, %.2f ms, %d", "command", static_cast<unsigned long long>(i), i * 0.001, -5).size();
+    });
+    Run("FORMAT_TO mixed", iterations, [&](size_t i) {
+        return FORMAT_TO(buffer, sizeof(buffer), "%s scope: %llu allocs, %.2f ms, %d", "command", static_cast<unsigned long long>(i), i * 0.001, -5);
+    });
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <thread>
+
+#include "utility/JobSystem.h"
+#include "utility/ThreadPool.h"
+
+// Scaling of the job system from one thread to all cores: a compute bound
+// parallel for, and the cost of many tiny jobs spawned on a worker and stolen
+// by the others, against the same jobs on the ThreadPool.
+// Run a release build: ./job-bench [max threads] [pin]
+
+static const size_t elementCount = 1 << 22;
+static const size_t grainSize = 16 * 1024;
+static const size_t tinyJobCount = 256 * 1024;
+// Spawned at once and waited for, small enough to never overflow into running inline
+static const size_t tinyJobBurst = 1024;
+static const int repeats = 5;
+
+static_assert(tinyJobBurst < jobDequeCapacity, "Bursts have to fit into a worker deque");
+static_assert(tinyJobCount % tinyJobBurst == 0, "Tiny jobs have to come in whole bursts");
+
+static volatile double sink = 0.0;
+
+// Best of a few runs in ms, the first run also warms up the workers
+static double Measure(const std::function<void()>& body) {
+    double best = 0.0;
+
+    for (int i = 0; i < repeats; i++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = i == 0 ? elapsed : std::min(best, elapsed);
+    }
+    return best;
+}
+
+static double RunParallelFor(JobSystem& jobs, std::vector<float>& data) {
+    return Measure([&]() {
+        jobs.ParallelFor(0, data.size(), grainSize, [&data](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                float x = static_cast<float>(i);
+                data[i] = std::sqrt(x) * std::sin(x) + std::cos(x * 0.5f);
+            }
+        });
+        sink = sink + data[data.size() / 2];
+    });
+}
+
+// The root job spawns bursts from a worker, so they go through that worker's deque
+// and the other workers steal from it. The caller only waits: helping would have it
+// run the root itself, and a root outside the workers spawns into the shared queue.
+static double RunTinyJobs(JobSystem& jobs) {
+    return Measure([&]() {
+        std::atomic<size_t> done { 0 };
+        JobCounter root;
+
+        jobs.Run([&]() {
+            for (size_t spawned = 0; spawned < tinyJobCount; spawned += tinyJobBurst) {
+                JobCounter burst;
+
+                for (size_t i = 0; i < tinyJobBurst; i++) {
+                    jobs.Run([&done]() { done.fetch_add(1, std::memory_order_relaxed); }, burst);
+                }
+                jobs.Wait(burst);
+            }
+        }, root);
+        while (!root.IsDone()) {
+            std::this_thread::yield();
+        }
+        sink = sink + done.load();
+    });
+}
+
+// Average steals per run of a case
+static double CountSteals(JobSystem& jobs, const std::function<double()>& run, double& ms) {
+    uint64_t before = jobs.GetStealCount();
+
+    ms = run();
+    return static_cast<double>(jobs.GetStealCount() - before) / repeats;
+}
+
+static double RunTinyThreadPoolJobs(ThreadPool& pool) {
+    return Measure([&]() {
+        std::atomic<size_t> done { 0 };
+
+        for (size_t i = 0; i < tinyJobCount; i++) {
+            pool.Enqueue([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.WaitIdle();
+        sink = sink + done.load();
+    });
+}
+
+int main(int argc, char** argv) {
+    size_t maxThreads = argc > 1 ? std::stoul(argv[1]) : JobSystem::GetDefaultWorkerCount() + 1;
+    bool pin = argc > 2 && std::string(argv[2]) == "pin";
+    std::vector<float> data(elementCount);
+    double baseFor = 0.0;
+    double baseTiny = 0.0;
+
+    printf("%zu elements in chunks of %zu, %zu tiny jobs in bursts of %zu%s\n",
+        elementCount, grainSize, tinyJobCount, tinyJobBurst, pin ? ", pinned workers" : "");
+    printf("%8s %10s %8s %10s %12s %8s %10s %12s\n",
+        "threads", "for ms", "speedup", "steals", "tiny ns/job", "speedup", "steals", "pool ns/job");
+
+    for (size_t threads = 1; threads <= std::max<size_t>(maxThreads, 1); threads++) {
+        // the parallel for caller helps while it waits, so n threads are n - 1 workers there
+        JobSystem forJobs { threads - 1, pin };
+        JobSystem tinyJobs { threads, pin };
+        ThreadPool pool { threads };
+        double forMs = 0.0;
+        double tinyMs = 0.0;
+
+        double forSteals = CountSteals(forJobs, [&]() { return RunParallelFor(forJobs, data); }, forMs);
+        double tinySteals = CountSteals(tinyJobs, [&]() { return RunTinyJobs(tinyJobs); }, tinyMs);
+        double poolMs = RunTinyThreadPoolJobs(pool);
+
+        if (threads == 1) {
+            baseFor = forMs;
+            baseTiny = tinyMs;
+        }
+        printf("%8zu %10.2f %7.2fx %10.0f %12.1f %7.2fx %10.0f %12.1f\n",
+            threads,
+            forMs,
+            baseFor / forMs,
+            forSteals,
+            tinyMs * 1e6 / tinyJobCount,
+            baseTiny / tinyMs,
+            tinySteals,
+            poolMs * 1e6 / tinyJobCount);
+    }
+    return 0;
+}
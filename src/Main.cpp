@@ -11,7 +11,7 @@ int main(int argc, char** argv) {
         app.Run();
     }
     catch(const std::runtime_error& e) {
-        ERROR(e.what());
+        LOG_ERROR(GENERAL, e.what());
         return 1;
     }
 
@@ -1,7 +1,16 @@
 #include "TestApp.h"
 
+static std::vector<engine::WindowDesc> CreateWindowDescs(int width, int height) {
+    std::vector<engine::WindowDesc> descs;
+
+    for (size_t i = 0; i < windowCount; i++) {
+        descs.push_back(engine::WindowDesc { width, height, FORMAT("Window Title %u", i + 1) });
+    }
+    return descs;
+}
+
 TestApp::TestApp(int width, int height):
-    engine { width, height } {
+    engine { CreateWindowDescs(width, height), renderMode, targetFps } {
 
 }
 
@@ -14,7 +23,26 @@ void TestApp::Run() {
 
 void TestApp::Mainloop() {
     while (!engine.ShouldQuit()) {
-        engine.DrawFrame();
         engine.HandleEvents();
+        HandleInput();
+        engine.DrawFrame();
+    }
+}
+
+void TestApp::HandleInput() {
+    engine::glfw::InputEvent event;
+
+    while (engine.PopInputEvent(event)) {
+        if (event.type != engine::glfw::InputEventType::KEY || event.action != GLFW_PRESS) {
+            continue;
+        }
+        // number keys switch between the swapchain presets
+        switch (event.code) {
+        case GLFW_KEY_1:    engine.SetSwapChainConfig(engine::vulkan::GetSwapChainPreset(engine::vulkan::SwapChainPreset::DEFAULT));       break;
+        case GLFW_KEY_2:    engine.SetSwapChainConfig(engine::vulkan::GetSwapChainPreset(engine::vulkan::SwapChainPreset::LOW_LATENCY));   break;
+        case GLFW_KEY_3:    engine.SetSwapChainConfig(engine::vulkan::GetSwapChainPreset(engine::vulkan::SwapChainPreset::LOW_POWER));     break;
+        case GLFW_KEY_4:    engine.SetSwapChainConfig(engine::vulkan::GetSwapChainPreset(engine::vulkan::SwapChainPreset::THROUGHPUT));    break;
+        default:            break;
+        }
     }
 }
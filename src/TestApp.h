@@ -5,10 +5,15 @@
 #include <iostream>
 #include <cstring>
 
-#include "utility/StringFormat.h"
+#include "utility/Format.h"
 #include "logging/StdLogger.h"
 #include "engine/Engine.h"
 
+const engine::RenderMode renderMode = engine::RenderMode::RENDER_THREAD;
+const double targetFps = 144.0;
+// every window shows the same scene, drawn from one device
+const size_t windowCount = 1;
+
 class TestApp {
 
 public:
@@ -23,5 +28,6 @@ private:
     engine::Engine  engine;
 
     void            Mainloop();
+    void            HandleInput();
 
 };
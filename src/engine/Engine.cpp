@@ -3,23 +3,276 @@
 
 namespace engine {
 
-Engine::Engine(int width, int height):
-    glfw { width, height, "Window Title" },
-    vulkan { glfw.GetWindow() } {
+Engine::Engine(int width, int height, RenderMode mode_, double targetFps):
+    Engine(std::vector<WindowDesc> { WindowDesc { width, height, "Window Title" } }, mode_, targetFps) {
+}
+
+Engine::Engine(const std::vector<WindowDesc>& windowDescs, RenderMode mode_, double targetFps):
+    startTime { std::chrono::steady_clock::now() },
+    mode { mode_ },
+    glfwContext {},
+    asyncIO {},
+    windows {},
+    vulkan { windowDescs.size(), [this, &windowDescs]() {
+        windows = CreateWindows(windowDescs);
+        return GetWindowHandles();
+    }, asyncIO },
+    inputHeads(windows.size(), glfw::InputEvent {}),
+    frameState { defaultFrameState },
+    publishedCount { 0 },
+    lastDrawnSequence { 0 },
+    lastPresentTime {},
+    statsGeneration { 0 },
+    rendering { false },
+    visible { true },
+    frameLimiter { targetFps },
+    idleTime { 0 },
+    firstFrameTime { 0 } {
+
+    logging::SetTraceThreadName("main");
+    RestartFrameStats();
+    UpdateWindowStates();
+    if (targetFps > 0.0) {
+        LOG_INFO(GENERAL, FORMAT("Limiting frame rate to %.1f fps", targetFps));
+    }
+
+    if (mode == RenderMode::RENDER_THREAD) {
+        rendering = true;
+        renderThread = std::thread { &Engine::RenderLoop, this };
+        LOG_INFO(GENERAL, "Started render thread");
+    }
+}
+
+Engine::~Engine() {
+    StopRenderThread();
+    LogThrottleStats();
+    LogFrameStats();
+}
+
+void Engine::LogFrameStats() const {
+    LOG_INFO(GENERAL, FORMAT("%s: frame time p50 <= %llu us, p99 <= %llu us, input to present latency p50 <= %llu us, p99 <= %llu us",
+        statsLabel,
+        static_cast<unsigned long long>(frameTime.GetPercentile(0.5)),
+        static_cast<unsigned long long>(frameTime.GetPercentile(0.99)),
+        static_cast<unsigned long long>(inputLatency.GetPercentile(0.5)),
+        static_cast<unsigned long long>(inputLatency.GetPercentile(0.99))));
+}
+
+void Engine::RestartFrameStats() {
+    statsGeneration = vulkan.GetSwapChainGeneration();
+    statsLabel = FORMAT("%s, %u images, %u frames in flight",
+        vulkan::GetPresentModeName(vulkan.GetPresentMode()),
+        vulkan.GetSwapChainImageCount(),
+        vulkan.GetFramesInFlight());
+    frameTime.Reset();
+    inputLatency.Reset();
+    lastPresentTime = {};
+}
+
+std::vector<std::unique_ptr<glfw::GLFW>> Engine::CreateWindows(const std::vector<WindowDesc>& windowDescs) {
+    std::vector<std::unique_ptr<glfw::GLFW>> created;
+
+    if (windowDescs.empty() || windowDescs.size() > maxWindows) {
+        throw std::runtime_error(FORMAT("Could not create %u windows, between 1 and %u are supported", windowDescs.size(), maxWindows));
+    }
+    for (const auto& desc: windowDescs) {
+        created.push_back(std::make_unique<glfw::GLFW>(desc.width, desc.height, desc.title));
+    }
+    return created;
+}
+
+std::vector<GLFWwindow*> Engine::GetWindowHandles() const {
+    std::vector<GLFWwindow*> handles;
 
+    for (const auto& window: windows) {
+        handles.push_back(window->GetWindow());
+    }
+    return handles;
+}
 
+ThrottleStats Engine::GetThrottleStats() const {
+    return ThrottleStats {
+        frameLimiter.GetThrottledTime(),
+        std::chrono::nanoseconds { idleTime.load(std::memory_order_relaxed) }
+    };
+}
+
+void Engine::LogThrottleStats() const {
+    ThrottleStats stats = GetThrottleStats();
+    double total = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    double limited = std::chrono::duration<double>(stats.limited).count();
+    double idle = std::chrono::duration<double>(stats.idle).count();
+
+    LOG_INFO(GENERAL, FORMAT("Throttled %.1f s of %.1f s, %.1f s by the frame limiter, %.1f s minimized",
+        limited + idle, total, limited, idle));
+}
+
+void Engine::StopRenderThread() {
+    if (renderThread.joinable()) {
+        rendering = false;
+        renderThread.join();
+        LOG_INFO(GENERAL, "Stopped render thread");
+    }
 }
 
 void Engine::HandleEvents() {
-    return glfw.PollEvents();
+    TRACE_SCOPE("Engine::HandleEvents");
+    if (!visible) {
+        // nothing to present, so sleep until a window comes back, waking up now and then for I/O
+        auto start = std::chrono::steady_clock::now();
+        windows.front()->WaitEvents(std::chrono::duration<double>(idleEventTimeout).count());
+        idleTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+        if (mode == RenderMode::SINGLE_THREADED) {
+            PumpIO();
+        }
+    } else if (mode == RenderMode::RENDER_THREAD) {
+        // nothing else to do on this thread, so sleep until input arrives or the render thread stops
+        windows.front()->WaitEvents();
+    } else {
+        // handles the events of every window
+        windows.front()->PollEvents();
+        PumpIO();
+    }
+    // the earliest event since the last frame, frames without input do not count towards latency
+    uint64_t eventTime = 0;
+    for (auto& window: windows) {
+        uint64_t windowEventTime = window->TakeFirstEventTime();
+        if (windowEventTime != 0 && (eventTime == 0 || windowEventTime < eventTime)) {
+            eventTime = windowEventTime;
+        }
+    }
+    if (eventTime != 0) {
+        GetFrameState().inputTime = glfw::GetInputTimePoint(eventTime);
+    }
+    UpdateWindowStates();
+}
+
+void Engine::UpdateWindowStates() {
+    FrameState& state = GetFrameState();
+    bool anyVisible = false;
+
+    state.windowCount = static_cast<uint32_t>(windows.size());
+    for (size_t i = 0; i < windows.size(); i++) {
+        int width = 0;
+        int height = 0;
+
+        if (!windows[i]->IsMinimized()) {
+            windows[i]->GetFramebufferSize(width, height);
+        }
+        state.windows[i] = WindowState { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+        anyVisible = anyVisible || (width > 0 && height > 0);
+    }
+    visible = anyVisible;
+}
+
+// Every ring is ordered already, so the oldest of their heads is the oldest event overall
+bool Engine::PopInputEvent(glfw::InputEvent& event) {
+    size_t oldest = inputHeads.size();
+
+    for (size_t i = 0; i < inputHeads.size(); i++) {
+        if (inputHeads[i].time == 0 && windows[i]->PopEvent(inputHeads[i])) {
+            inputHeads[i].window = static_cast<uint8_t>(i);
+        }
+        if (inputHeads[i].time != 0 && (oldest == inputHeads.size() || inputHeads[i].time < inputHeads[oldest].time)) {
+            oldest = i;
+        }
+    }
+    if (oldest == inputHeads.size()) {
+        return false;
+    }
+    event = inputHeads[oldest];
+    inputHeads[oldest].time = 0;
+    return true;
 }
 
 bool Engine::ShouldQuit() {
-    return glfw.ShouldCloseWindow();
+    bool closed = std::any_of(windows.begin(), windows.end(), [](const std::unique_ptr<glfw::GLFW>& window) {
+        return window->ShouldCloseWindow();
+    });
+    return closed || (mode == RenderMode::RENDER_THREAD && !rendering);
 }
 
 void Engine::DrawFrame() {
-    vulkan.DrawFrame();
+    GetFrameState().sequence = ++publishedCount;
+    frameState.Publish();
+    // the published state keeps it, through later publishes too, until the render thread takes it
+    GetFrameState().inputTime = {};
+
+    if (mode == RenderMode::SINGLE_THREADED) {
+        if (visible) {
+            Render();
+            frameLimiter.Wait();
+        }
+    } else if (!rendering) {
+        StopRenderThread();
+        if (renderError) {
+            std::rethrow_exception(renderError);
+        }
+    }
+}
+
+void Engine::PumpIO() {
+    TRACE_SCOPE("Engine::PumpIO");
+    // reads queued since the last frame go out together, finished ones are handed over here
+    asyncIO.Submit();
+    asyncIO.Poll();
+}
+
+void Engine::Render() {
+    TRACE_SCOPE("Engine::Render");
+    FrameState state;
+
+    frameState.Acquire(state);
+    bool presented = vulkan.DrawFrame(state);
+
+    // each swapchain configuration gets its own numbers
+    if (vulkan.GetSwapChainGeneration() != statsGeneration) {
+        LogFrameStats();
+        RestartFrameStats();
+    }
+    if (!presented) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+
+    if (firstFrameTime.load(std::memory_order_relaxed) == 0) {
+        auto sinceStart = std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime);
+        firstFrameTime.store(sinceStart.count(), std::memory_order_relaxed);
+        BLOG_INFO(GENERAL, "First frame presented %.1f ms after startup",
+            std::chrono::duration<double, std::milli>(sinceStart).count());
+    }
+    if (lastPresentTime != std::chrono::steady_clock::time_point {}) {
+        frameTime.Record(std::chrono::duration_cast<std::chrono::microseconds>(now - lastPresentTime).count());
+    }
+    lastPresentTime = now;
+
+    // a state drawn more than once only counts the first time
+    if (state.sequence != lastDrawnSequence && state.inputTime != std::chrono::steady_clock::time_point {}) {
+        lastDrawnSequence = state.sequence;
+        inputLatency.Record(std::chrono::duration_cast<std::chrono::microseconds>(now - state.inputTime).count());
+    }
+}
+
+void Engine::RenderLoop() {
+    logging::SetTraceThreadName("render");
+    try {
+        while (rendering) {
+            PumpIO();
+            if (visible) {
+                Render();
+                frameLimiter.Wait();
+            } else {
+                std::this_thread::sleep_for(idleRenderInterval);
+            }
+        }
+    }
+    catch (...) {
+        renderError = std::current_exception();
+        rendering = false;
+        // the main thread may be waiting for input, it has to see the error
+        glfw::Context::WakeWaitingEvents();
+    }
 }
 
 
@@ -1,25 +1,118 @@
 #pragma once
 
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <algorithm>
+#include <stdexcept>
+
+#include "io/AsyncIO.h"
+#include "io/IoStats.h"
+#include "glfw/Context.h"
 #include "glfw/GLFW.h"
 #include "vulkan/Vulkan.h"
+#include "FrameLimiter.h"
+#include "FrameState.h"
+#include "StateBuffer.h"
 
 namespace engine {
 
+enum class RenderMode {
+    SINGLE_THREADED,
+    // GLFW events stay on the main thread, rendering and asset I/O completion run on their own thread
+    RENDER_THREAD
+};
+
+// How long a minimized window sleeps on events, and its render thread between checks
+const std::chrono::milliseconds idleEventTimeout { 100 };
+const std::chrono::milliseconds idleRenderInterval { 10 };
+
+struct WindowDesc {
+    int                         width;
+    int                         height;
+    std::string                 title;
+};
+
+struct ThrottleStats {
+    // waiting for the frame limiter
+    std::chrono::nanoseconds    limited;
+    // not drawing because the window was minimized
+    std::chrono::nanoseconds    idle;
+};
+
 class Engine {
 
 public:
 
-                        Engine(int width, int height);
+                        Engine(int width, int height, RenderMode mode_ = RenderMode::SINGLE_THREADED, double targetFps = 0.0);
+    // All windows are drawn from one device, up to maxWindows
+                        Engine(const std::vector<WindowDesc>& windowDescs, RenderMode mode_ = RenderMode::SINGLE_THREADED, double targetFps = 0.0);
+                        ~Engine();
 
     void                HandleEvents();
     bool                ShouldQuit();
+    // Publishes the frame state, and draws it unless a render thread does
     void                DrawFrame();
+    FrameState&         GetFrameState() { return frameState.GetBack(); }
+    // Input events of all windows in the order they happened, drained by one thread at a time
+    bool                PopInputEvent(glfw::InputEvent& event);
+    size_t              GetWindowCount() const { return windows.size(); }
+    vulkan::HostAllocationStats GetHostAllocationStats() const { return vulkan.GetHostAllocationStats(); }
+    io::AsyncIO&        GetAsyncIO() { return asyncIO; }
+    // Belongs to the rendering thread, as do completions of AsyncIO reads
+    vulkan::TextureStreamer* GetTextureStreamer() { return vulkan.GetTextureStreamer(); }
+    // Safe from any thread, takes effect with the next frame drawn
+    void                SetSwapChainConfig(const vulkan::SwapChainConfig& config) { vulkan.SetSwapChainConfig(config); }
+    // Microseconds from the first input event a frame reflects to presenting it.
+    // Like the frame times, restarted whenever the swapchain configuration changes.
+    const io::Log2Histogram& GetInputLatency() const { return inputLatency; }
+    // Microseconds between presented frames
+    const io::Log2Histogram& GetFrameTime() const { return frameTime; }
+    ThrottleStats       GetThrottleStats() const;
+    // From the start of the constructor to the first presented frame, 0 until then
+    std::chrono::nanoseconds GetTimeToFirstFrame() const { return std::chrono::nanoseconds { firstFrameTime.load(std::memory_order_relaxed) }; }
 
 
 private:
-    glfw::GLFW          glfw;
+    std::chrono::steady_clock::time_point startTime;
+    RenderMode          mode;
+    glfw::Context       glfwContext;
+    io::AsyncIO         asyncIO;
+    // filled in by vulkan's startup, which creates the windows on this thread
+    std::vector<std::unique_ptr<glfw::GLFW>>    windows;
     vulkan::Vulkan      vulkan;
+    // oldest queued event per window, time 0 if none was taken yet
+    std::vector<glfw::InputEvent> inputHeads;
+    StateBuffer<FrameState> frameState;
+    uint64_t            publishedCount;
+    uint64_t            lastDrawnSequence;
+    io::Log2Histogram   inputLatency;
+    io::Log2Histogram   frameTime;
+    std::chrono::steady_clock::time_point lastPresentTime;
+    uint32_t            statsGeneration;
+    std::string         statsLabel;
+    std::atomic<bool>   rendering;
+    std::atomic<bool>   visible;
+    FrameLimiter        frameLimiter;
+    std::atomic<int64_t> idleTime;
+    std::atomic<int64_t> firstFrameTime;
+    std::exception_ptr  renderError;
+    std::thread         renderThread;
 
+    static std::vector<std::unique_ptr<glfw::GLFW>> CreateWindows(const std::vector<WindowDesc>& windowDescs);
+    std::vector<GLFWwindow*>    GetWindowHandles() const;
+    void                UpdateWindowStates();
+    void                PumpIO();
+    void                Render();
+    void                RenderLoop();
+    void                StopRenderThread();
+    void                LogThrottleStats() const;
+    void                LogFrameStats() const;
+    void                RestartFrameStats();
 
 };
 
@@ -0,0 +1,65 @@
+#include "FrameLimiter.h"
+
+namespace engine {
+
+// sleeps are never trusted to be more precise than this
+static const std::chrono::microseconds minSpinMargin { 100 };
+static const std::chrono::microseconds initialSpinMargin { 1000 };
+
+FrameLimiter::FrameLimiter(double targetFps):
+    frameTime { Clock::duration::zero() },
+    nextFrame {},
+    spinMargin { initialSpinMargin },
+    throttledTime { 0 } {
+
+    if (targetFps > 0.0) {
+        frameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double> { 1.0 / targetFps });
+    }
+}
+
+double FrameLimiter::GetTargetFps() const {
+    if (frameTime == Clock::duration::zero()) {
+        return 0.0;
+    }
+    return 1.0 / std::chrono::duration<double>(frameTime).count();
+}
+
+void FrameLimiter::Wait() {
+    if (frameTime == Clock::duration::zero()) {
+        return;
+    }
+    Clock::time_point start = Clock::now();
+
+    if (start >= nextFrame) {
+        // a frame more than a whole period late restarts the schedule instead of rushing the next ones
+        if (start - nextFrame > frameTime) {
+            nextFrame = start;
+        }
+        nextFrame += frameTime;
+        return;
+    }
+
+    TRACE_SCOPE("FrameLimiter::Wait");
+    Clock::time_point wake = nextFrame - spinMargin;
+    if (start < wake) {
+        std::this_thread::sleep_until(wake);
+
+        // grow the margin to a late wakeup at once, shrink it slowly while sleeps are on time
+        Clock::duration late = Clock::now() - wake;
+        if (late > spinMargin) {
+            spinMargin = std::min<Clock::duration>(late, frameTime / 2);
+        } else {
+            spinMargin -= (spinMargin - late) / 16;
+        }
+        spinMargin = std::max<Clock::duration>(spinMargin, minSpinMargin);
+    }
+    while (Clock::now() < nextFrame) {
+        std::this_thread::yield();
+    }
+
+    throttledTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count(),
+        std::memory_order_relaxed);
+    nextFrame += frameTime;
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#include "logging/Trace.h"
+
+namespace engine {
+
+// Paces a loop to a target frame rate. Most of the remaining frame time is
+// slept away, the last part is spun, and the spin margin follows how late
+// recent sleeps woke up.
+class FrameLimiter {
+
+public:
+    // A target of 0 leaves the frame rate unlimited
+    explicit                FrameLimiter(double targetFps);
+
+    // Blocks until the next frame is due
+    void                    Wait();
+    double                  GetTargetFps() const;
+    // Total time spent waiting, readable from any thread
+    std::chrono::nanoseconds GetThrottledTime() const { return std::chrono::nanoseconds { throttledTime.load(std::memory_order_relaxed) }; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::duration         frameTime;
+    Clock::time_point       nextFrame;
+    Clock::duration         spinMargin;
+    std::atomic<int64_t>    throttledTime;
+};
+
+}
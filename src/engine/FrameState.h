@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace engine {
+
+const size_t maxWindows = 8;
+
+struct WindowState {
+    // framebuffer size, 0 while the window is minimized
+    uint32_t                                width;
+    uint32_t                                height;
+};
+
+// Everything a frame needs from the simulation, copied to the render thread as a whole
+struct FrameState {
+    uint64_t                                sequence;
+    float                                   offset[2];
+    float                                   scale;
+    float                                   color[4];
+    // first input event this state reflects, for input to present latency. Default if there was none.
+    // Carried over from published states the render thread skipped.
+    std::chrono::steady_clock::time_point   inputTime;
+    // filled in by the engine from the main thread, GLFW may not be asked from the render thread
+    uint32_t                                windowCount;
+    WindowState                             windows[maxWindows];
+};
+
+// Several states published between two frames drawn keep the earliest input time
+inline void MergeSuperseded(FrameState& published, const FrameState& superseded) {
+    const std::chrono::steady_clock::time_point none {};
+
+    if (superseded.inputTime != none && (published.inputTime == none || superseded.inputTime < published.inputTime)) {
+        published.inputTime = superseded.inputTime;
+    }
+}
+
+const FrameState defaultFrameState { 0, { 0.0f, 0.0f }, 1.0f, { 1.0f, 0.0f, 0.0f, 1.0f }, {}, 0, {} };
+
+}
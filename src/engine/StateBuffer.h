@@ -0,0 +1,66 @@
+#pragma once
+
+#include <mutex>
+
+namespace engine {
+
+// Overloaded for types that have to carry something over from a state the reader missed
+template<typename T>
+void MergeSuperseded(T&, const T&) {
+}
+
+// Double buffered state shared by one writer and one reader. The writer
+// edits the back copy without locking, Publish swaps it to the front, and
+// the reader takes a copy of the front, so neither waits for the other's work.
+// A state published over one the reader never took goes through MergeSuperseded.
+template<typename T>
+class StateBuffer {
+
+public:
+    explicit                StateBuffer(const T& initial);
+
+    T&                      GetBack() { return slots[1 - front]; }
+    void                    Publish();
+
+    // Copies the latest published state, returns false if it was already acquired
+    bool                    Acquire(T& state);
+
+private:
+    std::mutex              mutex;
+    T                       slots[2];
+    int                     front;
+    bool                    fresh;
+};
+
+template<typename T>
+StateBuffer<T>::StateBuffer(const T& initial):
+    slots { initial, initial },
+    front { 0 },
+    fresh { false } {
+}
+
+template<typename T>
+void StateBuffer<T>::Publish() {
+    {
+        std::lock_guard<std::mutex> lock { mutex };
+        if (fresh) {
+            MergeSuperseded(slots[1 - front], slots[front]);
+        }
+        front = 1 - front;
+        fresh = true;
+    }
+    // the reader only touches the front, so the new back can be refreshed unlocked
+    slots[1 - front] = slots[front];
+}
+
+template<typename T>
+bool StateBuffer<T>::Acquire(T& state) {
+    std::lock_guard<std::mutex> lock { mutex };
+    bool wasFresh = fresh;
+
+    state = slots[front];
+    fresh = false;
+    return wasFresh;
+}
+
+}
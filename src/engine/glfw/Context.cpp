@@ -0,0 +1,21 @@
+#include "Context.h"
+
+namespace engine::glfw {
+
+Context::Context() {
+    LOG_INFO(GLFW, "Initializing glfw");
+    if (glfwInit() != GLFW_TRUE) {
+        throw std::runtime_error("Could not initialize glfw");
+    }
+}
+
+Context::~Context() {
+    glfwTerminate();
+    LOG_INFO(GLFW, "Destroyed glfw");
+}
+
+void Context::WakeWaitingEvents() {
+    glfwPostEmptyEvent();
+}
+
+}
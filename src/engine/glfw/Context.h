@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <GLFW/glfw3.h>
+
+#include "logging/StdLogger.h"
+
+namespace engine::glfw {
+
+// Initializes glfw for as long as it lives, so the Vulkan instance can be set up
+// on another thread while the main thread creates windows. Main thread only,
+// except for WakeWaitingEvents.
+class Context {
+public:
+                            Context();
+                            Context(const Context& other) = delete;
+                            ~Context();
+
+    Context&                operator=(const Context& other) = delete;
+
+    // Returns the main thread from WaitEvents, safe from any thread while the context lives
+    static void             WakeWaitingEvents();
+};
+
+}
@@ -2,22 +2,42 @@
 
 namespace engine::glfw {
 
+// events are only pushed from GLFW callbacks, on the thread polling for them
+static uint64_t lastEventTime = 0;
+
+static GLFW& GetInstance(GLFWwindow* window) {
+    return *static_cast<GLFW*>(glfwGetWindowUserPointer(window));
+}
+
 GLFW::GLFW(int width_, int height_, const std::string& windowTitle):
     width { width_ },
-    height { height_ } {
-
-    INFO("Initializing glfw");
+    height { height_ },
+    droppedEvents { 0 },
+    firstEventTime { 0 } {
 
-    glfwInit();
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 
     window = glfwCreateWindow(width, height, windowTitle.c_str(), nullptr, nullptr);
+    if (window == nullptr) {
+        throw std::runtime_error("Could not create glfw window");
+    }
+    LoadCallbacks();
 }
 
 GLFW::~GLFW() {
     glfwDestroyWindow(window);
-    glfwTerminate();
-    INFO("Destroyed glfw");
+    if (droppedEvents > 0) {
+        LOG_WARN(GLFW, FORMAT("Dropped %llu input events on a full queue", static_cast<unsigned long long>(droppedEvents.load())));
+    }
+}
+
+void GLFW::LoadCallbacks() {
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, &GLFW::KeyCallback);
+    glfwSetMouseButtonCallback(window, &GLFW::MouseButtonCallback);
+    glfwSetCursorPosCallback(window, &GLFW::CursorPosCallback);
+    glfwSetScrollCallback(window, &GLFW::ScrollCallback);
+    glfwSetFramebufferSizeCallback(window, &GLFW::FramebufferSizeCallback);
 }
 
 GLFWwindow* GLFW::GetWindow() {
@@ -28,8 +48,79 @@ bool GLFW::ShouldCloseWindow() const {
     return glfwWindowShouldClose(window);
 }
 
+void GLFW::GetFramebufferSize(int& framebufferWidth, int& framebufferHeight) const {
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+}
+
+bool GLFW::IsMinimized() const {
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED)) {
+        return true;
+    }
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    return framebufferWidth == 0 || framebufferHeight == 0;
+}
+
 void GLFW::PollEvents() {
     glfwPollEvents();
 }
 
+void GLFW::WaitEvents(double timeout) {
+    glfwWaitEventsTimeout(timeout);
+}
+
+void GLFW::WaitEvents() {
+    glfwWaitEvents();
+}
+
+uint64_t GLFW::TakeFirstEventTime() {
+    uint64_t time = firstEventTime;
+    firstEventTime = 0;
+    return time;
+}
+
+void GLFW::PushEvent(InputEvent event) {
+    // strictly increasing across all windows, so Engine can merge their queues by time alone
+    event.time = std::max(event.time, lastEventTime + 1);
+    lastEventTime = event.time;
+    if (firstEventTime == 0) {
+        firstEventTime = event.time;
+    }
+    // nothing to block on inside a callback, a consumer this far behind loses the newest events
+    if (!inputQueue.TryPush(event)) {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void GLFW::KeyCallback(GLFWwindow* window, int key, int, int action, int mods) {
+    GetInstance(window).PushEvent(InputEvent { GetInputTime(), InputEventType::KEY,
+        static_cast<uint8_t>(action), static_cast<uint8_t>(mods), 0, key, 0.0f, 0.0f });
+}
+
+void GLFW::MouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    GetInstance(window).PushEvent(InputEvent { GetInputTime(), InputEventType::MOUSE_BUTTON,
+        static_cast<uint8_t>(action), static_cast<uint8_t>(mods), 0, button, 0.0f, 0.0f });
+}
+
+void GLFW::CursorPosCallback(GLFWwindow* window, double x, double y) {
+    GetInstance(window).PushEvent(InputEvent { GetInputTime(), InputEventType::CURSOR_MOVE,
+        0, 0, 0, 0, static_cast<float>(x), static_cast<float>(y) });
+}
+
+void GLFW::ScrollCallback(GLFWwindow* window, double x, double y) {
+    GetInstance(window).PushEvent(InputEvent { GetInputTime(), InputEventType::SCROLL,
+        0, 0, 0, 0, static_cast<float>(x), static_cast<float>(y) });
+}
+
+void GLFW::FramebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    GLFW& instance = GetInstance(window);
+
+    instance.width = width;
+    instance.height = height;
+    instance.PushEvent(InputEvent { GetInputTime(), InputEventType::FRAMEBUFFER_RESIZE,
+        0, 0, 0, 0, static_cast<float>(width), static_cast<float>(height) });
+}
+
 }
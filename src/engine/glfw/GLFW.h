@@ -1,13 +1,22 @@
 #pragma once
 
 #include <string>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
 
 #include <GLFW/glfw3.h>
 
 #include "logging/StdLogger.h"
+#include "utility/Format.h"
+#include "utility/SpscRing.h"
+#include "InputEvent.h"
 
 namespace engine::glfw {
 
+const size_t inputQueueCapacity = 1024;
+
+// One window and its input queue, created and destroyed on the main thread while a Context is alive
 class GLFW {
 public:
                             GLFW(int width_, int height_, const std::string& windowtitle);
@@ -15,14 +24,36 @@ public:
 
     GLFWwindow*             GetWindow();
     void                    PollEvents();
+    void                    WaitEvents(double timeout);
+    // Until an event arrives or Context::WakeWaitingEvents is called
+    void                    WaitEvents();
     bool                    ShouldCloseWindow() const;
+    // Iconified or without a framebuffer to draw into
+    bool                    IsMinimized() const;
+    void                    GetFramebufferSize(int& framebufferWidth, int& framebufferHeight) const;
+
+    // Consumer side of the input queue, one thread at a time
+    bool                    PopEvent(InputEvent& event) { return inputQueue.TryPop(event); }
+    // Time of the first event since the last call, 0 if there was none. Event polling thread only.
+    uint64_t                TakeFirstEventTime();
+    uint64_t                GetDroppedEventCount() const { return droppedEvents.load(std::memory_order_relaxed); }
 
 private:
     int                     width;
     int                     height;
     GLFWwindow*             window;
-
-
+    SpscRing<InputEvent, inputQueueCapacity>    inputQueue;
+    std::atomic<uint64_t>   droppedEvents;
+    uint64_t                firstEventTime;
+
+    void                    LoadCallbacks();
+    void                    PushEvent(InputEvent event);
+
+    static void             KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void             MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void             CursorPosCallback(GLFWwindow* window, double x, double y);
+    static void             ScrollCallback(GLFWwindow* window, double x, double y);
+    static void             FramebufferSizeCallback(GLFWwindow* window, int width, int height);
 };
 
 }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+namespace engine::glfw {
+
+enum class InputEventType: uint8_t {
+    KEY,
+    MOUSE_BUTTON,
+    CURSOR_MOVE,
+    SCROLL,
+    FRAMEBUFFER_RESIZE
+};
+
+// 24 bytes, so a burst of events stays within a few cache lines
+struct InputEvent {
+    // steady clock nanoseconds, taken in the GLFW callback
+    uint64_t        time;
+    InputEventType  type;
+    // GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT for keys and buttons
+    uint8_t         action;
+    uint8_t         mods;
+    // index of the engine window the event belongs to, filled in by Engine::PopInputEvent
+    uint8_t         window;
+    // GLFW key or mouse button
+    int32_t         code;
+    // cursor position, scroll offset or framebuffer size
+    float           x;
+    float           y;
+};
+
+static_assert(sizeof(InputEvent) == 24, "Unexpected input event size");
+
+inline uint64_t GetInputTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline std::chrono::steady_clock::time_point GetInputTimePoint(uint64_t time) {
+    return std::chrono::steady_clock::time_point { std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds { time }) };
+}
+
+}
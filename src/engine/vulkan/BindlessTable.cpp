@@ -0,0 +1,193 @@
+#include "BindlessTable.h"
+
+namespace engine::vulkan {
+
+IndexAllocator::IndexAllocator(uint32_t capacity_):
+    capacity { capacity_ },
+    next { 0 } {
+}
+
+uint32_t IndexAllocator::Allocate() {
+    if (!freeList.empty()) {
+        uint32_t index = freeList.back();
+        freeList.pop_back();
+        return index;
+    }
+    if (next >= capacity) {
+        throw std::runtime_error("Bindless table is full");
+    }
+    return next++;
+}
+
+void IndexAllocator::Free(uint32_t index) {
+    freeList.push_back(index);
+}
+
+BindlessTable::BindlessTable(VkDevice device_, const VkAllocationCallbacks* allocator_, size_t frameCount, uint32_t textureCapacity, uint32_t bufferCapacity):
+    device { device_ },
+    allocator { allocator_ },
+    layout { VK_NULL_HANDLE },
+    pool { VK_NULL_HANDLE },
+    set { VK_NULL_HANDLE },
+    textureIndices { textureCapacity },
+    bufferIndices { bufferCapacity },
+    currentFrame { 0 },
+    pendingTextureFrees(frameCount),
+    pendingBufferFrees(frameCount) {
+
+    LoadLayout();
+    LoadPool();
+    LoadSet();
+    LOG_INFO(DESCRIPTORS, FORMAT("Created bindless table for %u textures, %u buffers", textureCapacity, bufferCapacity));
+}
+
+BindlessTable::~BindlessTable() {
+    if (pool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(device, pool, allocator);
+    }
+    if (layout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(device, layout, allocator);
+    }
+    LOG_DEBUG(DESCRIPTORS, "Destroyed bindless table");
+}
+
+void BindlessTable::LoadLayout() {
+    VkDescriptorSetLayoutBinding bindings[2] {};
+    VkDescriptorBindingFlagsEXT bindingFlags[2] {};
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT flagsInfo {};
+    VkDescriptorSetLayoutCreateInfo createInfo {};
+
+    bindings[0].binding = textureBinding;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = textureIndices.GetCapacity();
+    bindings[0].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+    bindings[1].binding = bufferBinding;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = bufferIndices.GetCapacity();
+    bindings[1].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+    // unused slots may stay empty, and slots not used by in flight frames may be rewritten
+    for (auto& flags: bindingFlags) {
+        flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+    }
+
+    flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    flagsInfo.bindingCount = 2;
+    flagsInfo.pBindingFlags = bindingFlags;
+
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    createInfo.pNext = &flagsInfo;
+    createInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    createInfo.bindingCount = 2;
+    createInfo.pBindings = bindings;
+
+    if (vkCreateDescriptorSetLayout(device, &createInfo, allocator, &layout) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create bindless descriptor set layout");
+    }
+}
+
+void BindlessTable::LoadPool() {
+    VkDescriptorPoolSize sizes[2] {};
+    VkDescriptorPoolCreateInfo createInfo {};
+
+    sizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    sizes[0].descriptorCount = textureIndices.GetCapacity();
+    sizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    sizes[1].descriptorCount = bufferIndices.GetCapacity();
+
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    createInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    createInfo.maxSets = 1;
+    createInfo.poolSizeCount = 2;
+    createInfo.pPoolSizes = sizes;
+
+    if (vkCreateDescriptorPool(device, &createInfo, allocator, &pool) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create bindless descriptor pool");
+    }
+}
+
+void BindlessTable::LoadSet() {
+    VkDescriptorSetAllocateInfo allocInfo {};
+
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &layout;
+
+    if (vkAllocateDescriptorSets(device, &allocInfo, &set) != VK_SUCCESS) {
+        throw std::runtime_error("Could not allocate bindless descriptor set");
+    }
+}
+
+void BindlessTable::BeginFrame(size_t frameIndex) {
+    currentFrame = frameIndex;
+
+    // indices released while this frame slot was last in flight are safe to hand out again
+    for (auto index: pendingTextureFrees[currentFrame]) {
+        textureIndices.Free(index);
+    }
+    for (auto index: pendingBufferFrees[currentFrame]) {
+        bufferIndices.Free(index);
+    }
+    pendingTextureFrees[currentFrame].clear();
+    pendingBufferFrees[currentFrame].clear();
+}
+
+uint32_t BindlessTable::AddTexture(VkImageView imageView, VkSampler sampler) {
+    uint32_t index = textureIndices.Allocate();
+    UpdateTexture(index, imageView, sampler);
+    return index;
+}
+
+void BindlessTable::UpdateTexture(uint32_t index, VkImageView imageView, VkSampler sampler) {
+    VkDescriptorImageInfo imageInfo {};
+    VkWriteDescriptorSet write {};
+
+    imageInfo.imageView = imageView;
+    imageInfo.sampler = sampler;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = textureBinding;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+void BindlessTable::RemoveTexture(uint32_t index) {
+    pendingTextureFrees[currentFrame].push_back(index);
+}
+
+uint32_t BindlessTable::AddBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+    uint32_t index = bufferIndices.Allocate();
+    VkDescriptorBufferInfo bufferInfo {};
+    VkWriteDescriptorSet write {};
+
+    bufferInfo.buffer = buffer;
+    bufferInfo.offset = offset;
+    bufferInfo.range = range;
+
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = bufferBinding;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &bufferInfo;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    return index;
+}
+
+void BindlessTable::RemoveBuffer(uint32_t index) {
+    pendingBufferFrees[currentFrame].push_back(index);
+}
+
+}
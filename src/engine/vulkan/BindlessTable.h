@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+
+namespace engine::vulkan {
+
+const bool preferBindless = true;
+
+const uint32_t invalidBindlessIndex = 0xFFFFFFFF;
+
+// Mirrors the fragment stage part of the push constant block, see DrawPushConstants
+struct BindlessIndices {
+    uint32_t    textureIndex;
+    uint32_t    bufferIndex;
+};
+
+class IndexAllocator {
+
+public:
+    explicit                IndexAllocator(uint32_t capacity_);
+
+    uint32_t                Allocate();
+    void                    Free(uint32_t index);
+    uint32_t                GetCapacity() const { return capacity; }
+    uint32_t                GetUsedCount() const { return next - static_cast<uint32_t>(freeList.size()); }
+
+private:
+    uint32_t                capacity;
+    uint32_t                next;
+    std::vector<uint32_t>   freeList;
+};
+
+// One global, partially bound and update-after-bind descriptor set holding
+// every texture and storage buffer. Shaders pick entries by index, so the
+// set is bound once per command buffer instead of once per draw.
+class BindlessTable {
+
+public:
+    static const uint32_t       textureBinding = 0;
+    static const uint32_t       bufferBinding = 1;
+
+                                BindlessTable(VkDevice device_,
+                                    const VkAllocationCallbacks* allocator_,
+                                    size_t frameCount,
+                                    uint32_t textureCapacity,
+                                    uint32_t bufferCapacity);
+                                ~BindlessTable();
+
+    void                        BeginFrame(size_t frameIndex);
+    uint32_t                    AddTexture(VkImageView imageView, VkSampler sampler);
+    void                        UpdateTexture(uint32_t index, VkImageView imageView, VkSampler sampler);
+    void                        RemoveTexture(uint32_t index);
+    uint32_t                    AddBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+    void                        RemoveBuffer(uint32_t index);
+
+    VkDescriptorSetLayout       GetLayout() const { return layout; }
+    VkDescriptorSet             GetSet() const { return set; }
+
+private:
+    VkDevice                            device;
+    const VkAllocationCallbacks*        allocator;
+    VkDescriptorSetLayout               layout;
+    VkDescriptorPool                    pool;
+    VkDescriptorSet                     set;
+    IndexAllocator                      textureIndices;
+    IndexAllocator                      bufferIndices;
+    size_t                              currentFrame;
+    std::vector<std::vector<uint32_t>>  pendingTextureFrees;
+    std::vector<std::vector<uint32_t>>  pendingBufferFrees;
+
+    void                        LoadLayout();
+    void                        LoadPool();
+    void                        LoadSet();
+};
+
+}
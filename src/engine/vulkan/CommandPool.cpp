@@ -2,36 +2,38 @@
 
 namespace engine::vulkan {
 
-CommandPool::CommandPool(VkDevice device_, const Queue& queue):
+CommandPool::CommandPool(VkDevice device_, const VkAllocationCallbacks* allocator_, const Queue& queue):
     device { device_ },
+    allocator { allocator_ },
     pool { VK_NULL_HANDLE } {
 
     VkCommandPoolCreateInfo createInfo {};
     createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     createInfo.queueFamilyIndex = queue.GetIndex();
-    createInfo.flags = 0;
+    // buffers are re-recorded every frame
+    createInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 
-    if (vkCreateCommandPool(device, &createInfo, nullptr, &pool) != VK_SUCCESS) {
+    if (vkCreateCommandPool(device, &createInfo, allocator, &pool) != VK_SUCCESS) {
         throw std::runtime_error("Could not create command pool");
     }
-    DEBUG("Created command pool");
+    LOG_DEBUG(VULKAN, "Created command pool");
 }
 
 CommandPool::~CommandPool() {
 
     if (buffers.size() > 0) {
         vkFreeCommandBuffers(device, pool, buffers.size(), buffers.data());
-        DEBUG("Destroyed command buffers");
+        LOG_DEBUG(VULKAN, "Destroyed command buffers");
     }
 
     if (pool != VK_NULL_HANDLE) {
-        vkDestroyCommandPool(device, pool, nullptr);
-        DEBUG("Destroyed command pool");
+        vkDestroyCommandPool(device, pool, allocator);
+        LOG_DEBUG(VULKAN, "Destroyed command pool");
     }
 }
 
-void CommandPool::LoadCommandBuffers(const SwapChain& swapchain) {
-    buffers.resize(swapchain.GetFramebufferCount());
+void CommandPool::LoadCommandBuffers(size_t count) {
+    buffers.resize(count);
     VkCommandBufferAllocateInfo allocInfo {};
 
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -42,43 +44,79 @@ void CommandPool::LoadCommandBuffers(const SwapChain& swapchain) {
     if (vkAllocateCommandBuffers(device, &allocInfo, buffers.data()) != VK_SUCCESS) {
         throw std::runtime_error("Could not create command buffers");
     }
-    DEBUG("Created command buffers");
+    LOG_DEBUG(VULKAN, "Created command buffers");
 }
 
-void CommandPool::RecordCommand(const SwapChain& swapchain, const Pipeline& pipeline) {
+void CommandPool::BeginFrame(size_t index) {
+    VkCommandBuffer buffer = buffers[index];
+    VkCommandBufferBeginInfo beginInfo {};
 
-    for(size_t i = 0; i < buffers.size(); i++) {
-        VkCommandBufferBeginInfo beginInfo {};
+    vkResetCommandBuffer(buffer, 0);
 
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
-        beginInfo.pInheritanceInfo = nullptr;
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = nullptr;
 
-        vkBeginCommandBuffer(buffers[i], &beginInfo);
-
-        VkRenderPassBeginInfo rpBeginInfo {};
-        rpBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        rpBeginInfo.renderPass = pipeline.GetRenderPass();
-        rpBeginInfo.framebuffer = swapchain.GetFramebuffer(i);
-        rpBeginInfo.renderArea.offset = { 0, 0 };
-        rpBeginInfo.renderArea.extent = swapchain.GetImageExtent();
+    vkBeginCommandBuffer(buffer, &beginInfo);
+}
 
-        VkClearValue clearColor { 0.0f, 0.0f, 0.0f, 1.0f };
-        rpBeginInfo.clearValueCount = 1;
-        rpBeginInfo.pClearValues = &clearColor;
+void CommandPool::RecordWindow(size_t index,
+    const SwapChain& swapchain,
+    uint32_t imageIndex,
+    const Pipeline& pipeline,
+    VkDescriptorSet uniformSet,
+    const BindlessTable* bindless,
+    const PresentTransfer* presentTransfer,
+    const std::vector<DrawCall>& draws) {
+
+    TRACE_SCOPE("CommandPool::RecordWindow");
+    VkCommandBuffer buffer = buffers[index];
+    VkRenderPassBeginInfo rpBeginInfo {};
+    rpBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    rpBeginInfo.renderPass = pipeline.GetRenderPass();
+    rpBeginInfo.framebuffer = swapchain.GetFramebuffer(imageIndex);
+    rpBeginInfo.renderArea.offset = { 0, 0 };
+    rpBeginInfo.renderArea.extent = swapchain.GetImageExtent();
+
+    VkClearValue clearColor { 0.0f, 0.0f, 0.0f, 1.0f };
+    rpBeginInfo.clearValueCount = 1;
+    rpBeginInfo.pClearValues = &clearColor;
+
+    vkCmdBeginRenderPass(buffer, &rpBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.GetPipeline());
+
+    VkViewport viewport { 0.0f, 0.0f,
+        static_cast<float>(swapchain.GetImageExtent().width),
+        static_cast<float>(swapchain.GetImageExtent().height),
+        0.0f, 1.0f };
+    vkCmdSetViewport(buffer, 0, 1, &viewport);
+    vkCmdSetScissor(buffer, 0, 1, &rpBeginInfo.renderArea);
+
+    if (pipeline.IsBindless() && bindless != nullptr) {
+        VkDescriptorSet bindlessSet = bindless->GetSet();
+
+        vkCmdBindDescriptorSets(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.GetLayout(), Pipeline::bindlessSetIndex, 1, &bindlessSet, 0, nullptr);
+    }
 
-        vkCmdBeginRenderPass(buffers[i], &rpBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    // same set for every draw, only the dynamic offset into the uniform ring moves
+    for (const auto& draw: draws) {
+        vkCmdBindDescriptorSets(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.GetLayout(), Pipeline::drawSetIndex, 1, &uniformSet, 1, &draw.uniformOffset);
+        pipeline.GetPushConstants().Push(buffer, pipeline.GetLayout(), draw.constants);
+        vkCmdDraw(buffer, draw.vertexCount, 1, 0, 0);
+    }
 
-        vkCmdBindPipeline(buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.GetPipeline());
-        vkCmdDraw(buffers[i], 3, 1, 0, 0);
+    vkCmdEndRenderPass(buffer);
 
-        vkCmdEndRenderPass(buffers[i]);
+    if (presentTransfer != nullptr) {
+        presentTransfer->RecordRelease(buffer, imageIndex);
+    }
+}
 
-        if (vkEndCommandBuffer(buffers[i]) != VK_SUCCESS) {
-            throw std::runtime_error("Could not record command buffer");
-        }
+void CommandPool::EndFrame(size_t index) {
+    if (vkEndCommandBuffer(buffers[index]) != VK_SUCCESS) {
+        throw std::runtime_error("Could not record command buffer");
     }
-    DEBUG("Recorded command");
 }
 
 }
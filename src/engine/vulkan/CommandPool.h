@@ -7,22 +7,41 @@
 #include "SwapChain.h"
 #include "Pipeline.h"
 #include "Queue.h"
+#include "BindlessTable.h"
+#include "PresentTransfer.h"
 
 namespace engine::vulkan {
 
+struct DrawCall {
+    uint32_t                uniformOffset;
+    uint32_t                vertexCount;
+    DrawPushConstants       constants;
+};
+
 class CommandPool {
 
 public:
 
-                            CommandPool(VkDevice device_, const Queue& queue);
+                            CommandPool(VkDevice device_, const VkAllocationCallbacks* allocator_, const Queue& queue);
                             ~CommandPool();
-    void                    LoadCommandBuffers(const SwapChain& swapchain);
-    void                    RecordCommand(const SwapChain& swapchain, const Pipeline& pipeline);
+    void                    LoadCommandBuffers(size_t count);
+    // One buffer per frame slot, holding a render pass for every window drawn that frame
+    void                    BeginFrame(size_t index);
+    void                    RecordWindow(size_t index,
+                                const SwapChain& swapchain,
+                                uint32_t imageIndex,
+                                const Pipeline& pipeline,
+                                VkDescriptorSet uniformSet,
+                                const BindlessTable* bindless,
+                                const PresentTransfer* presentTransfer,
+                                const std::vector<DrawCall>& draws);
+    void                    EndFrame(size_t index);
     VkCommandBuffer*        GetCommandBufferPtr(size_t index) { return buffers.data() + index; }
 
 private:
 
     VkDevice                        device;
+    const VkAllocationCallbacks*    allocator;
     VkCommandPool                   pool;
     std::vector<VkCommandBuffer>    buffers;
 
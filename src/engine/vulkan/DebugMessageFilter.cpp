@@ -0,0 +1,110 @@
+#include "DebugMessageFilter.h"
+
+namespace engine::vulkan {
+
+static int64_t GetNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// FNV-1a, continued from seed
+static uint64_t HashString(const char* str, uint64_t seed) {
+    uint64_t hash = seed;
+
+    while (str != nullptr && *str != 0) {
+        hash = (hash ^ static_cast<uint8_t>(*str++)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+DebugMessageFilter::DebugMessageFilter(std::chrono::nanoseconds interval_):
+    entries(validationFilterCapacity),
+    interval { interval_.count() },
+    overflowCount { 0 } {
+}
+
+// Without an id number (0) the name alone is too coarse, debug_report passes
+// the layer prefix there and the loader names all its messages alike, so the
+// message text is part of the key then
+uint64_t DebugMessageFilter::HashMessage(int32_t idNumber, const char* idName, const char* message) {
+    uint64_t hash = HashString(idName, 14695981039346656037ull ^ static_cast<uint32_t>(idNumber));
+
+    if (idNumber == 0) {
+        hash = HashString(message, hash);
+    }
+    // 0 marks an empty slot
+    return hash != 0 ? hash : 1;
+}
+
+DebugMessageDecision DebugMessageFilter::Filter(uint64_t messageId, const char* name) {
+    Entry* entry = FindOrInsert(messageId, name);
+
+    if (entry == nullptr) {
+        overflowCount.fetch_add(1, std::memory_order_relaxed);
+        return DebugMessageDecision { true, 0 };
+    }
+    uint32_t count = entry->count.fetch_add(1, std::memory_order_relaxed) + 1;
+    int64_t now = GetNowNs();
+    int64_t last = entry->lastReport.load(std::memory_order_relaxed);
+
+    // first sighting or interval elapsed, only the thread winning the exchange reports
+    if ((count == 1 || now - last >= interval) &&
+        entry->lastReport.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+        uint32_t reported = entry->reportedCount.exchange(count, std::memory_order_relaxed);
+        return DebugMessageDecision { true, count - reported - 1 };
+    }
+    return DebugMessageDecision { false, 0 };
+}
+
+DebugMessageFilter::Entry* DebugMessageFilter::FindOrInsert(uint64_t key, const char* name) {
+    size_t mask = entries.size() - 1;
+
+    for (size_t probe = 0; probe < entries.size(); probe++) {
+        Entry& entry = entries[(key + probe) & mask];
+        uint64_t current = entry.key.load(std::memory_order_acquire);
+
+        if (current == key) {
+            return &entry;
+        }
+        if (current == 0) {
+            if (entry.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                std::strncpy(entry.name, name != nullptr ? name : "", nameLength - 1);
+                entry.name[nameLength - 1] = 0;
+                entry.named.store(true, std::memory_order_release);
+                return &entry;
+            }
+            if (current == key) {
+                return &entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void DebugMessageFilter::LogSummary() const {
+    uint32_t unique = 0;
+    uint64_t total = 0;
+
+    for (const auto& entry: entries) {
+        uint32_t count = entry.count.load(std::memory_order_relaxed);
+
+        if (entry.key.load(std::memory_order_acquire) == 0 || count == 0) {
+            continue;
+        }
+        unique++;
+        total += count;
+        if (count > 1) {
+            LOG_WARN(VALIDATION, FORMAT("Validation message %s reported %u times",
+                entry.named.load(std::memory_order_acquire) ? entry.name : "?",
+                count));
+        }
+    }
+    if (unique > 0 || overflowCount.load() > 0) {
+        LOG_INFO(VALIDATION, FORMAT("Validation summary: %u unique messages, %llu total, %llu past table capacity",
+            unique,
+            static_cast<unsigned long long>(total),
+            static_cast<unsigned long long>(overflowCount.load())));
+    }
+}
+
+}
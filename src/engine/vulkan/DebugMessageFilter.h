@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstring>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+
+namespace engine::vulkan {
+
+const std::chrono::seconds validationReportInterval { 5 };
+const size_t validationFilterCapacity = 1024;
+
+struct DebugMessageDecision {
+    bool            report;
+    uint32_t        suppressed;     // repeats swallowed since the last report
+};
+
+// Counts validation messages by id in a fixed size, lock-free open addressing
+// table. Each unique message is let through at most once per interval along with
+// the number of repeats it swallowed in between. Messages arriving once the
+// table is full are always reported.
+class DebugMessageFilter {
+
+public:
+    explicit                DebugMessageFilter(std::chrono::nanoseconds interval_);
+
+    DebugMessageDecision    Filter(uint64_t messageId, const char* name);
+    void                    LogSummary() const;
+    static uint64_t         HashMessage(int32_t idNumber, const char* idName, const char* message);
+
+private:
+    static const size_t     nameLength = 64;
+
+    struct Entry {
+        std::atomic<uint64_t>   key;
+        std::atomic<bool>       named;
+        std::atomic<uint32_t>   count;
+        std::atomic<uint32_t>   reportedCount;
+        std::atomic<int64_t>    lastReport;
+        char                    name[nameLength];
+    };
+
+    std::vector<Entry>      entries;
+    int64_t                 interval;
+    std::atomic<uint64_t>   overflowCount;
+
+    Entry*                  FindOrInsert(uint64_t key, const char* name);
+};
+
+}
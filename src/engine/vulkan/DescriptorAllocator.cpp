@@ -0,0 +1,265 @@
+#include "DescriptorAllocator.h"
+
+namespace engine::vulkan {
+
+static const uint32_t initialPoolSize = 64;
+static const uint32_t maxPoolSize = 4096;
+
+// Descriptors reserved per set, by type. A pool can hold maxSets * ratio descriptors of each.
+static const std::vector<std::pair<VkDescriptorType, float>> poolRatios {
+    { VK_DESCRIPTOR_TYPE_SAMPLER,                   0.5f },
+    { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,    4.0f },
+    { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,             4.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,             1.0f },
+    { VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,      1.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,      1.0f },
+    { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,            2.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,            2.0f },
+    { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,    1.0f },
+    { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,    1.0f },
+    { VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,          0.5f }
+};
+
+static void HashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+bool DescriptorBinding::IsImage() const {
+    switch (type) {
+    case VK_DESCRIPTOR_TYPE_SAMPLER:
+    case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+    case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+    case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+    case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool DescriptorBinding::IsTexelBuffer() const {
+    return type == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+}
+
+bool DescriptorBinding::operator==(const DescriptorBinding& other) const {
+    if (binding != other.binding || type != other.type) {
+        return false;
+    }
+    if (IsImage()) {
+        return imageInfo.imageView == other.imageInfo.imageView &&
+            imageInfo.sampler == other.imageInfo.sampler &&
+            imageInfo.imageLayout == other.imageInfo.imageLayout;
+    }
+    if (IsTexelBuffer()) {
+        return texelBufferView == other.texelBufferView;
+    }
+    return bufferInfo.buffer == other.bufferInfo.buffer &&
+        bufferInfo.offset == other.bufferInfo.offset &&
+        bufferInfo.range == other.bufferInfo.range;
+}
+
+DescriptorBinding CreateBufferBinding(uint32_t binding, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+    DescriptorBinding db {};
+
+    db.binding = binding;
+    db.type = type;
+    db.bufferInfo.buffer = buffer;
+    db.bufferInfo.offset = offset;
+    db.bufferInfo.range = range;
+
+    return db;
+}
+
+DescriptorBinding CreateImageBinding(uint32_t binding, VkDescriptorType type, VkImageView imageView, VkSampler sampler, VkImageLayout layout) {
+    DescriptorBinding db {};
+
+    db.binding = binding;
+    db.type = type;
+    db.imageInfo.imageView = imageView;
+    db.imageInfo.sampler = sampler;
+    db.imageInfo.imageLayout = layout;
+
+    return db;
+}
+
+DescriptorBinding CreateTexelBufferBinding(uint32_t binding, VkDescriptorType type, VkBufferView bufferView) {
+    DescriptorBinding db {};
+
+    db.binding = binding;
+    db.type = type;
+    db.texelBufferView = bufferView;
+
+    return db;
+}
+
+size_t HashBindings(VkDescriptorSetLayout layout, const std::vector<DescriptorBinding>& bindings) {
+    size_t seed = std::hash<VkDescriptorSetLayout>()(layout);
+
+    for (const auto& b: bindings) {
+        HashCombine(seed, b.binding);
+        HashCombine(seed, static_cast<size_t>(b.type));
+        if (b.IsImage()) {
+            HashCombine(seed, std::hash<VkImageView>()(b.imageInfo.imageView));
+            HashCombine(seed, std::hash<VkSampler>()(b.imageInfo.sampler));
+            HashCombine(seed, static_cast<size_t>(b.imageInfo.imageLayout));
+        }
+        else if (b.IsTexelBuffer()) {
+            HashCombine(seed, std::hash<VkBufferView>()(b.texelBufferView));
+        }
+        else {
+            HashCombine(seed, std::hash<VkBuffer>()(b.bufferInfo.buffer));
+            HashCombine(seed, static_cast<size_t>(b.bufferInfo.offset));
+            HashCombine(seed, static_cast<size_t>(b.bufferInfo.range));
+        }
+    }
+    return seed;
+}
+
+DescriptorAllocator::DescriptorAllocator(VkDevice device_, const VkAllocationCallbacks* allocator_, size_t frameCount):
+    device { device_ },
+    allocator { allocator_ },
+    frames(frameCount),
+    currentFrame { 0 },
+    nextPoolSize { initialPoolSize },
+    poolCount { 0 } {
+
+    LOG_DEBUG(DESCRIPTORS, "Created descriptor allocator");
+}
+
+DescriptorAllocator::~DescriptorAllocator() {
+    for (auto& frame: frames) {
+        for (auto pool: frame.usedPools) {
+            vkDestroyDescriptorPool(device, pool, allocator);
+        }
+    }
+    for (auto pool: freePools) {
+        vkDestroyDescriptorPool(device, pool, allocator);
+    }
+    LOG_DEBUG(DESCRIPTORS, FORMAT("Destroyed descriptor allocator (%zu pools)", poolCount));
+}
+
+void DescriptorAllocator::BeginFrame(size_t frameIndex) {
+    currentFrame = frameIndex;
+    FramePools& frame = frames[currentFrame];
+
+    for (auto pool: frame.usedPools) {
+        vkResetDescriptorPool(device, pool, 0);
+        freePools.push_back(pool);
+    }
+    frame.usedPools.clear();
+    frame.cache.clear();
+}
+
+VkDescriptorSet DescriptorAllocator::Allocate(VkDescriptorSetLayout layout) {
+    FramePools& frame = frames[currentFrame];
+    VkDescriptorSet set = VK_NULL_HANDLE;
+
+    if (!frame.usedPools.empty() && TryAllocate(frame.usedPools.back(), layout, set)) {
+        return set;
+    }
+
+    // current pool is exhausted or fragmented, chain a fresh one
+    frame.usedPools.push_back(AcquirePool());
+    if (!TryAllocate(frame.usedPools.back(), layout, set)) {
+        throw std::runtime_error("Could not allocate descriptor set");
+    }
+    return set;
+}
+
+VkDescriptorSet DescriptorAllocator::GetSet(VkDescriptorSetLayout layout, const std::vector<DescriptorBinding>& bindings) {
+    FramePools& frame = frames[currentFrame];
+    auto& bucket = frame.cache[HashBindings(layout, bindings)];
+
+    for (const auto& cached: bucket) {
+        if (cached.layout == layout && cached.bindings == bindings) {
+            return cached.set;
+        }
+    }
+
+    VkDescriptorSet set = Allocate(layout);
+    WriteSet(set, bindings);
+    bucket.push_back(CachedSet { layout, bindings, set });
+    return set;
+}
+
+VkDescriptorPool DescriptorAllocator::AcquirePool() {
+    if (!freePools.empty()) {
+        VkDescriptorPool pool = freePools.back();
+        freePools.pop_back();
+        return pool;
+    }
+
+    VkDescriptorPool pool = CreatePool(nextPoolSize);
+    nextPoolSize = std::min(nextPoolSize * 2, maxPoolSize);
+    return pool;
+}
+
+VkDescriptorPool DescriptorAllocator::CreatePool(uint32_t maxSets) {
+    std::vector<VkDescriptorPoolSize> sizes;
+    VkDescriptorPoolCreateInfo createInfo {};
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+
+    for (const auto& ratio: poolRatios) {
+        VkDescriptorPoolSize size {};
+        size.type = ratio.first;
+        size.descriptorCount = std::max(1u, static_cast<uint32_t>(ratio.second * maxSets));
+        sizes.push_back(size);
+    }
+
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    createInfo.flags = 0;
+    createInfo.maxSets = maxSets;
+    createInfo.poolSizeCount = static_cast<uint32_t>(sizes.size());
+    createInfo.pPoolSizes = sizes.data();
+
+    if (vkCreateDescriptorPool(device, &createInfo, allocator, &pool) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create descriptor pool");
+    }
+    poolCount++;
+    BLOG_DEBUG(DESCRIPTORS, "Created descriptor pool for %u sets", maxSets);
+    return pool;
+}
+
+bool DescriptorAllocator::TryAllocate(VkDescriptorPool pool, VkDescriptorSetLayout layout, VkDescriptorSet& set) {
+    VkDescriptorSetAllocateInfo allocInfo {};
+
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &layout;
+
+    switch (vkAllocateDescriptorSets(device, &allocInfo, &set)) {
+    case VK_SUCCESS:                    return true;
+    case VK_ERROR_OUT_OF_POOL_MEMORY:
+    case VK_ERROR_FRAGMENTED_POOL:      return false;
+    default:                            throw std::runtime_error("Could not allocate descriptor set");
+    }
+}
+
+void DescriptorAllocator::WriteSet(VkDescriptorSet set, const std::vector<DescriptorBinding>& bindings) {
+    std::vector<VkWriteDescriptorSet> writes;
+
+    for (const auto& b: bindings) {
+        VkWriteDescriptorSet write {};
+
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        write.dstBinding = b.binding;
+        write.dstArrayElement = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = b.type;
+        if (b.IsImage()) {
+            write.pImageInfo = &b.imageInfo;
+        }
+        else if (b.IsTexelBuffer()) {
+            write.pTexelBufferView = &b.texelBufferView;
+        }
+        else {
+            write.pBufferInfo = &b.bufferInfo;
+        }
+        writes.push_back(write);
+    }
+    vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <functional>
+#include <stdexcept>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+
+namespace engine::vulkan {
+
+struct DescriptorBinding {
+    uint32_t                binding;
+    VkDescriptorType        type;
+    VkDescriptorBufferInfo  bufferInfo;
+    VkDescriptorImageInfo   imageInfo;
+    VkBufferView            texelBufferView;
+
+    bool                    IsImage() const;
+    bool                    IsTexelBuffer() const;
+    bool                    operator==(const DescriptorBinding& other) const;
+};
+
+DescriptorBinding CreateBufferBinding(uint32_t binding,
+    VkDescriptorType type,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkDeviceSize range);
+DescriptorBinding CreateImageBinding(uint32_t binding,
+    VkDescriptorType type,
+    VkImageView imageView,
+    VkSampler sampler,
+    VkImageLayout layout);
+DescriptorBinding CreateTexelBufferBinding(uint32_t binding,
+    VkDescriptorType type,
+    VkBufferView bufferView);
+
+// Hands out descriptor sets from chains of pools, one chain per frame in flight.
+// Sets are never freed individually: BeginFrame resets every pool the frame
+// used with vkResetDescriptorPool and returns them for reuse.
+class DescriptorAllocator {
+
+public:
+                                DescriptorAllocator(VkDevice device_,
+                                    const VkAllocationCallbacks* allocator_,
+                                    size_t frameCount);
+                                ~DescriptorAllocator();
+
+    void                        BeginFrame(size_t frameIndex);
+    VkDescriptorSet             Allocate(VkDescriptorSetLayout layout);
+    VkDescriptorSet             GetSet(VkDescriptorSetLayout layout, const std::vector<DescriptorBinding>& bindings);
+
+    size_t                      GetPoolCount() const { return poolCount; }
+
+private:
+    struct CachedSet {
+        VkDescriptorSetLayout           layout;
+        std::vector<DescriptorBinding>  bindings;
+        VkDescriptorSet                 set;
+    };
+
+    struct FramePools {
+        std::vector<VkDescriptorPool>                       usedPools;
+        std::unordered_map<size_t, std::vector<CachedSet>>  cache;
+    };
+
+    VkDevice                        device;
+    const VkAllocationCallbacks*    allocator;
+    std::vector<FramePools>         frames;
+    std::vector<VkDescriptorPool>   freePools;
+    size_t                          currentFrame;
+    uint32_t                        nextPoolSize;
+    size_t                          poolCount;
+
+    VkDescriptorPool            AcquirePool();
+    VkDescriptorPool            CreatePool(uint32_t maxSets);
+    bool                        TryAllocate(VkDescriptorPool pool, VkDescriptorSetLayout layout, VkDescriptorSet& set);
+    void                        WriteSet(VkDescriptorSet set, const std::vector<DescriptorBinding>& bindings);
+};
+
+size_t HashBindings(VkDescriptorSetLayout layout, const std::vector<DescriptorBinding>& bindings);
+
+}
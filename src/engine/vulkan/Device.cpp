@@ -2,7 +2,7 @@
 
 namespace engine::vulkan {
 
-std::vector<Device> GetDevices(VkInstance instance, VkSurfaceKHR surface) {
+std::vector<Device> GetDevices(VkInstance instance, VkSurfaceKHR surface, const VkAllocationCallbacks* allocator) {
     uint32_t deviceCount = 0;
     std::vector<VkPhysicalDevice> physicalDevices;
     std::vector<Device> devices;
@@ -13,23 +13,30 @@ std::vector<Device> GetDevices(VkInstance instance, VkSurfaceKHR surface) {
       vkEnumeratePhysicalDevices(instance, &deviceCount, physicalDevices.data());
     }
     for (auto device: physicalDevices) {
-        devices.emplace_back(device, surface);
+        devices.emplace_back(device, surface, allocator);
     }
     return devices;
 }
 
-Device::Device(VkPhysicalDevice physicalDevice_, VkSurfaceKHR surface):
+Device::Device(VkPhysicalDevice physicalDevice_, VkSurfaceKHR surface, const VkAllocationCallbacks* allocator_):
     physicalDevice { physicalDevice_ },
     logicalDevice { VK_NULL_HANDLE },
+    allocator { allocator_ },
+    bindlessEnabled { false },
+    presentQueueRecords { false },
     graphicsQueue { },
     presentQueue { } {
 
+    TRACE_SCOPE("Device::Device");
     LoadQueueFamilyIndices(surface);
 }
 
 Device::Device(Device&& other):
     physicalDevice { other.physicalDevice},
     logicalDevice { other.logicalDevice },
+    allocator { other.allocator },
+    bindlessEnabled { other.bindlessEnabled },
+    presentQueueRecords { other.presentQueueRecords },
     graphicsQueue { other.graphicsQueue },
     presentQueue { other.presentQueue } {
 
@@ -39,8 +46,8 @@ Device::Device(Device&& other):
 
 Device::~Device() {
     if (logicalDevice != VK_NULL_HANDLE) {
-        vkDestroyDevice(logicalDevice, nullptr);
-        INFO("Destroyed logical device");
+        vkDestroyDevice(logicalDevice, allocator);
+        LOG_INFO(DEVICE, "Destroyed logical device");
     }
 }
 
@@ -52,19 +59,31 @@ void Device::LoadQueueFamilyIndices(VkSurfaceKHR surface) {
     queueFamilies.resize(queueFamilyCount);
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
 
-    int i = 0;
-    for (const auto& qf: queueFamilies) {
-        if (qf.queueCount > 0) {
-            if (qf.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
-                graphicsQueue.SetIndex(i);
-            }
-            VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
-            if (presentSupport) {
-                presentQueue.SetIndex(i);
-            }
+    // a family doing both needs neither concurrent sharing nor ownership transfers,
+    // otherwise the first graphics and the first present family are used
+    for (int i = 0; i < static_cast<int>(queueFamilies.size()); i++) {
+        const auto& qf = queueFamilies[i];
+        VkBool32 presentSupport = false;
+
+        if (qf.queueCount == 0) {
+            continue;
+        }
+        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+        bool graphics = (qf.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+
+        if (graphics && presentSupport) {
+            graphicsQueue.SetIndex(i);
+            presentQueue.SetIndex(i);
+            presentQueueRecords = true;
+            return;
+        }
+        if (graphics && graphicsQueue.GetIndex() == -1) {
+            graphicsQueue.SetIndex(i);
+        }
+        if (presentSupport && presentQueue.GetIndex() == -1) {
+            presentQueue.SetIndex(i);
+            presentQueueRecords = (qf.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT)) != 0;
         }
-        i++;
     }
 }
 
@@ -94,9 +113,9 @@ void Device::LoadDeviceQueueInfo(VkDeviceCreateInfo& createInfo, std::vector<VkD
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(dqCreateInfo.size());
 }
 
-void Device::LoadDeviceExtensions(VkDeviceCreateInfo& createInfo) {
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(requiredDeviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = requiredDeviceExtensions.data();
+void Device::LoadDeviceExtensions(VkDeviceCreateInfo& createInfo, const std::vector<const char*>& extensions) {
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
 }
 
 void Device::LoadValidationLayers(VkDeviceCreateInfo& createInfo) {
@@ -109,32 +128,79 @@ void Device::LoadValidationLayers(VkDeviceCreateInfo& createInfo) {
     }
 }
 
-void Device::LoadLogicalDevice() {
+void Device::LoadLogicalDevice(bool enableBindless) {
+    TRACE_SCOPE("Device::LoadLogicalDevice");
     VkDeviceCreateInfo createInfo {};
     std::vector<VkDeviceQueueCreateInfo> dqCreateInfo;
+    std::vector<const char*> extensions { requiredDeviceExtensions };
     VkPhysicalDeviceFeatures requestedFeatures { VK_FALSE };
+    VkPhysicalDeviceFeatures2 requestedFeatures2 {};
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures {};
 
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    createInfo.pEnabledFeatures = &requestedFeatures;
+
+    if (enableBindless) {
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+        indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+
+        requestedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        requestedFeatures2.pNext = &indexingFeatures;
+        requestedFeatures2.features.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+        requestedFeatures2.features.shaderStorageBufferArrayDynamicIndexing = VK_TRUE;
+
+        // features come through the pNext chain, pEnabledFeatures must stay null
+        createInfo.pNext = &requestedFeatures2;
+        createInfo.pEnabledFeatures = nullptr;
+        extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    }
+    else {
+        createInfo.pEnabledFeatures = &requestedFeatures;
+    }
 
     LoadDeviceQueueInfo(createInfo, dqCreateInfo);
-    LoadDeviceExtensions(createInfo);
+    LoadDeviceExtensions(createInfo, extensions);
     LoadValidationLayers(createInfo);
 
-    if (vkCreateDevice(physicalDevice, &createInfo, nullptr, &logicalDevice) != VK_SUCCESS) {
+    if (vkCreateDevice(physicalDevice, &createInfo, allocator, &logicalDevice) != VK_SUCCESS) {
         throw std::runtime_error("Could not create logical device");
     }
-    INFO("Created logical device");
+    bindlessEnabled = enableBindless;
+    LOG_INFO(DEVICE, FORMAT("Created logical device (bindless %s)", bindlessEnabled ? "enabled" : "disabled"));
     LoadQueueFamilyQueues();
 
 }
 
-std::unique_ptr<SwapChain> Device::CreateSwapChain(VkSurfaceKHR surface) {
+std::unique_ptr<SwapChain> Device::CreateSwapChain(VkSurfaceKHR surface, const SwapChainConfig& config, VkExtent2D windowExtent, VkSwapchainKHR oldSwapChain) const {
     return std::make_unique<SwapChain>(physicalDevice,
         logicalDevice,
+        allocator,
         surface,
         graphicsQueue.GetIndex(),
-        presentQueue.GetIndex());
+        presentQueue.GetIndex(),
+        graphicsQueue.GetIndex() != presentQueue.GetIndex() && !UsesQueueOwnershipTransfer(),
+        config,
+        windowExtent,
+        oldSwapChain);
+}
+
+bool Device::SupportsPresent(VkSurfaceKHR surface) const {
+    VkBool32 presentSupport = false;
+
+    if (presentQueue.GetIndex() < 0) {
+        return false;
+    }
+    vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, presentQueue.GetIndex(), surface, &presentSupport);
+    return presentSupport;
+}
+
+bool Device::UsesQueueOwnershipTransfer() const {
+    return graphicsQueue.GetIndex() != presentQueue.GetIndex() &&
+        preferQueueOwnershipTransfer &&
+        presentQueueRecords;
 }
 
 bool Device::SupportsRequiredExtensions() const {
@@ -161,14 +227,134 @@ bool Device::SupportsRequiredExtensions() const {
     return found == requiredExtensions.size();
 }
 
+bool Device::SupportsExtension(const char* name) const {
+    uint32_t extCount = 0;
+    std::vector<VkExtensionProperties> availableExtensions;
+
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extCount, nullptr);
+    availableExtensions.resize(extCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extCount, availableExtensions.data());
+
+    for (const auto& e: availableExtensions) {
+        if (strcmp(e.extensionName, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Only valid on a vulkan 1.1 instance, vkGetPhysicalDeviceFeatures2 is core there
+bool Device::SupportsDescriptorIndexing() const {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    if (properties.apiVersion < VK_API_VERSION_1_1 ||
+        !SupportsExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+        return false;
+    }
+
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures {};
+    VkPhysicalDeviceFeatures2 features {};
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &indexingFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+    return features.features.shaderSampledImageArrayDynamicIndexing &&
+        features.features.shaderStorageBufferArrayDynamicIndexing &&
+        indexingFeatures.runtimeDescriptorArray &&
+        indexingFeatures.descriptorBindingPartiallyBound &&
+        indexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+        indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind &&
+        indexingFeatures.descriptorBindingUpdateUnusedWhilePending;
+}
+
+VkPhysicalDeviceDescriptorIndexingPropertiesEXT Device::GetDescriptorIndexingProperties() const {
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties {};
+    VkPhysicalDeviceProperties2 properties {};
+
+    indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &indexingProperties;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+    return indexingProperties;
+}
+
 bool Device::QueuesComplete() const {
     return graphicsQueue.GetIndex() != -1 && presentQueue.GetIndex() != -1;
 }
 
+bool Device::HasDedicatedTransferQueue() const {
+    uint32_t queueFamilyCount = 0;
+    std::vector<VkQueueFamilyProperties> queueFamilies;
+
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+    queueFamilies.resize(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+    return std::any_of(queueFamilies.begin(), queueFamilies.end(), [](const VkQueueFamilyProperties& qf) {
+        return qf.queueCount > 0 &&
+            (qf.queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+            !(qf.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT));
+    });
+}
+
 std::string Device::GetName() const {
     VkPhysicalDeviceProperties properties;
     vkGetPhysicalDeviceProperties(physicalDevice, &properties);
     return std::string(properties.deviceName);
 }
 
+VkPhysicalDeviceProperties Device::GetProperties() const {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    return properties;
+}
+
+VkDeviceSize Device::GetDeviceLocalMemory() const {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    VkDeviceSize largest = 0;
+
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+    for (uint32_t i = 0; i < memProperties.memoryHeapCount; i++) {
+        if (memProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            largest = std::max(largest, memProperties.memoryHeaps[i].size);
+        }
+    }
+    return largest;
+}
+
+std::string Device::GetUuid() const {
+    if (GetProperties().apiVersion < VK_API_VERSION_1_1) {
+        return std::string();
+    }
+    VkPhysicalDeviceIDProperties idProperties {};
+    VkPhysicalDeviceProperties2 properties {};
+    std::string uuid;
+
+    idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &idProperties;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+    for (auto byte: idProperties.deviceUUID) {
+        uuid += FORMAT("%02x", byte);
+    }
+    return uuid;
+}
+
+int Device::FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeBits & (1u << i)) &&
+            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
 }
@@ -5,7 +5,7 @@
 
 #include <vulkan/vulkan.h>
 
-#include "utility/StringFormat.h"
+#include "utility/Format.h"
 #include "initialization/ValidationLayer.h"
 
 #include "SwapChain.h"
@@ -21,35 +21,62 @@ class Device {
 
 public:
 
-    explicit                        Device(VkPhysicalDevice physicalDevice_, VkSurfaceKHR surface);
+    explicit                        Device(VkPhysicalDevice physicalDevice_,
+                                        VkSurfaceKHR surface,
+                                        const VkAllocationCallbacks* allocator_);
                                     Device(Device&& other);
                                     ~Device();
-    void                            LoadLogicalDevice();
-    std::unique_ptr<SwapChain>      CreateSwapChain(VkSurfaceKHR surface);
+    void                            LoadLogicalDevice(bool enableBindless);
+    std::unique_ptr<SwapChain>      CreateSwapChain(VkSurfaceKHR surface,
+                                        const SwapChainConfig& config,
+                                        VkExtent2D windowExtent,
+                                        VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE) const;
+    VkSurfaceFormatKHR              GetSurfaceFormat(VkSurfaceKHR surface) const { return ChooseSurfaceFormat(physicalDevice, surface); }
 
     bool                            SupportsRequiredExtensions() const;
+    bool                            SupportsExtension(const char* name) const;
+    bool                            SupportsDescriptorIndexing() const;
+    bool                            IsBindlessEnabled() const { return bindlessEnabled; }
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT GetDescriptorIndexingProperties() const;
     bool                            QueuesComplete() const;
+    bool                            SharesGraphicsAndPresentQueue() const { return graphicsQueue.GetIndex() == presentQueue.GetIndex(); }
+    // A transfer family without graphics or compute, usually backed by a copy engine
+    bool                            HasDedicatedTransferQueue() const;
+    bool                            SupportsPresent(VkSurfaceKHR surface) const;
+    // Exclusive swapchain images handed between differing graphics and present families
+    bool                            UsesQueueOwnershipTransfer() const;
 
     VkDevice                        GetLogicalDevice() const { return logicalDevice; }
+    const VkAllocationCallbacks*    GetAllocator() const { return allocator; }
     const Queue&                    GetGraphicsQueue() const { return graphicsQueue; }
     const Queue&                    GetPresentQueue() const { return presentQueue; }
     std::string                     GetName() const;
+    VkPhysicalDeviceProperties      GetProperties() const;
+    // Size of the largest device local heap
+    VkDeviceSize                    GetDeviceLocalMemory() const;
+    // Hex device UUID, empty before vulkan 1.1. Only valid on a vulkan 1.1 instance.
+    std::string                     GetUuid() const;
+    int                             FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
 private:
     VkPhysicalDevice                physicalDevice;
     VkDevice                        logicalDevice;
+    const VkAllocationCallbacks*    allocator;
+    bool                            bindlessEnabled;
+    // the present family can record barriers, which a present only family cannot
+    bool                            presentQueueRecords;
 
     Queue                           graphicsQueue;
     Queue                           presentQueue;
 
     void                            LoadQueueFamilyIndices(VkSurfaceKHR surface);
     void                            LoadQueueFamilyQueues();
-    void                            LoadDeviceExtensions(VkDeviceCreateInfo& createInfo);
+    void                            LoadDeviceExtensions(VkDeviceCreateInfo& createInfo, const std::vector<const char*>& extensions);
     void                            LoadValidationLayers(VkDeviceCreateInfo& createInfo);
     void                            LoadDeviceQueueInfo(VkDeviceCreateInfo& createInfo, std::vector<VkDeviceQueueCreateInfo>& dqCreateInfo);
 
 };
 
-std::vector<Device> GetDevices(VkInstance instance, VkSurfaceKHR surface);
+std::vector<Device> GetDevices(VkInstance instance, VkSurfaceKHR surface, const VkAllocationCallbacks* allocator);
 
 }
@@ -0,0 +1,168 @@
+#include "DeviceSelection.h"
+
+namespace engine::vulkan {
+
+// a discrete gpu wins over everything else, the other categories decide between similar devices
+static const int64_t maxMemoryScore = 512;
+static const int64_t memoryScorePerGiB = 32;
+static const int64_t transferQueueScore = 25;
+static const int64_t bindlessScore = 100;
+static const int64_t sharedQueueScore = 50;
+
+static int64_t GetTypeScore(VkPhysicalDeviceType type) {
+    switch (type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:      return 1000;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:    return 400;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:       return 300;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:               return 0;
+    default:                                        return 100;
+    }
+}
+
+static const char* GetTypeName(VkPhysicalDeviceType type) {
+    switch (type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:      return "discrete";
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:    return "integrated";
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:       return "virtual";
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:               return "cpu";
+    default:                                        return "other";
+    }
+}
+
+DeviceScore ScoreDevice(const Device& device, const std::vector<VkSurfaceKHR>& surfaces, bool bindlessAvailable) {
+    DeviceScore score { nullptr, 0, 0, 0, 0, 0 };
+
+    // queue families are picked for the first window, the others have to be able to present from them too
+    if (!device.QueuesComplete()) {
+        score.rejection = "no graphics or present queue";
+        return score;
+    }
+    if (!device.SupportsRequiredExtensions()) {
+        score.rejection = "missing required extensions";
+        return score;
+    }
+    bool presentsEverywhere = std::all_of(surfaces.begin(), surfaces.end(), [&device](VkSurfaceKHR surface) {
+        return device.SupportsPresent(surface);
+    });
+    if (!presentsEverywhere) {
+        score.rejection = "can not present to every window";
+        return score;
+    }
+
+    VkPhysicalDeviceProperties properties { device.GetProperties() };
+    int64_t memoryGiB = static_cast<int64_t>(device.GetDeviceLocalMemory() / (1024 * 1024 * 1024));
+
+    score.type = GetTypeScore(properties.deviceType);
+    score.memory = std::min(memoryGiB * memoryScorePerGiB, maxMemoryScore);
+    score.limits = properties.limits.maxImageDimension2D / 1024;
+    score.transfer = device.HasDedicatedTransferQueue() ? transferQueueScore : 0;
+    if (bindlessAvailable && device.SupportsDescriptorIndexing()) {
+        score.features += bindlessScore;
+    }
+    if (device.SharesGraphicsAndPresentQueue()) {
+        score.features += sharedQueueScore;
+    }
+    return score;
+}
+
+static bool IsNumber(const std::string& str) {
+    return !str.empty() && std::all_of(str.begin(), str.end(), [](char c) { return isdigit(static_cast<unsigned char>(c)) != 0; });
+}
+
+static std::string ToLower(std::string str) {
+    for (auto& c: str) {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+    return str;
+}
+
+// A UUID may be given with dashes, as most tools print it
+static std::string NormalizeUuid(const std::string& str) {
+    std::string uuid;
+
+    for (char c: str) {
+        if (c != '-') {
+            uuid += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    bool hex = std::all_of(uuid.begin(), uuid.end(), [](char c) { return isxdigit(static_cast<unsigned char>(c)) != 0; });
+    return hex && uuid.size() == 2 * VK_UUID_SIZE ? uuid : std::string();
+}
+
+static bool MatchesOverride(const Device& device, size_t index, const std::string& value, uint32_t instanceApiVersion) {
+    if (IsNumber(value)) {
+        return std::strtoull(value.c_str(), nullptr, 10) == index;
+    }
+    std::string uuid = NormalizeUuid(value);
+    if (!uuid.empty() && instanceApiVersion >= VK_API_VERSION_1_1) {
+        return device.GetUuid() == uuid;
+    }
+    return ToLower(device.GetName()).find(ToLower(value)) != std::string::npos;
+}
+
+static int FindOverride(const std::vector<Device>& devices, const std::vector<DeviceScore>& scores, uint32_t instanceApiVersion) {
+    const char* value = std::getenv(deviceEnvVar);
+
+    if (value == nullptr || *value == 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < devices.size(); i++) {
+        if (!MatchesOverride(devices[i], i, value, instanceApiVersion)) {
+            continue;
+        }
+        if (scores[i].rejection != nullptr) {
+            LOG_WARN(DEVICE, FORMAT("%s=%s names %s, which can not be used: %s",
+                deviceEnvVar, value, devices[i].GetName(), scores[i].rejection));
+            return -1;
+        }
+        return static_cast<int>(i);
+    }
+    LOG_WARN(DEVICE, FORMAT("%s=%s matches no device, picking by score", deviceEnvVar, value));
+    return -1;
+}
+
+size_t SelectDevice(const std::vector<Device>& devices, const std::vector<VkSurfaceKHR>& surfaces, uint32_t instanceApiVersion, bool bindlessAvailable) {
+    std::vector<DeviceScore> scores;
+    int best = -1;
+
+    for (size_t i = 0; i < devices.size(); i++) {
+        scores.push_back(ScoreDevice(devices[i], surfaces, bindlessAvailable));
+        if (scores[i].rejection != nullptr) {
+            LOG_DEBUG(DEVICE, FORMAT("Device %u, %s: rejected, %s", i, devices[i].GetName(), scores[i].rejection));
+            continue;
+        }
+        LOG_DEBUG(DEVICE, FORMAT("Device %u, %s: score %lld", i, devices[i].GetName(), static_cast<long long>(scores[i].GetTotal())));
+        // ties go to the first device, as the driver lists it first
+        if (best == -1 || scores[i].GetTotal() > scores[best].GetTotal()) {
+            best = static_cast<int>(i);
+        }
+    }
+    if (best == -1) {
+        throw std::runtime_error("Could not find appropriate device");
+    }
+
+    int chosen = FindOverride(devices, scores, instanceApiVersion);
+    bool overridden = chosen != -1;
+    if (!overridden) {
+        chosen = best;
+    }
+    const Device& device = devices[chosen];
+    const DeviceScore& score = scores[chosen];
+
+    LOG_INFO(DEVICE, FORMAT("Used device %u: %s, %s, %llu MiB, score %lld (type %lld, memory %lld, limits %lld, transfer %lld, features %lld)%s%s",
+        chosen,
+        device.GetName(),
+        GetTypeName(device.GetProperties().deviceType),
+        static_cast<unsigned long long>(device.GetDeviceLocalMemory() / (1024 * 1024)),
+        static_cast<long long>(score.GetTotal()),
+        static_cast<long long>(score.type),
+        static_cast<long long>(score.memory),
+        static_cast<long long>(score.limits),
+        static_cast<long long>(score.transfer),
+        static_cast<long long>(score.features),
+        overridden ? ", picked by " : "",
+        overridden ? deviceEnvVar : ""));
+    return static_cast<size_t>(chosen);
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <stdexcept>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+#include "Device.h"
+
+namespace engine::vulkan {
+
+// Picks the device instead of the scoring: its index in enumeration order,
+// its UUID in hex, or part of its name, e.g. TV_DEVICE=nvidia
+const char* const deviceEnvVar = "TV_DEVICE";
+
+// Points per category, the device with the highest total is used
+struct DeviceScore {
+    // why the device can not be used at all, nullptr if it can
+    const char*     rejection;
+    int64_t         type;
+    int64_t         memory;
+    int64_t         limits;
+    int64_t         transfer;
+    int64_t         features;
+
+    int64_t         GetTotal() const { return type + memory + limits + transfer + features; }
+};
+
+DeviceScore ScoreDevice(const Device& device, const std::vector<VkSurfaceKHR>& surfaces, bool bindlessAvailable);
+// Index of the device named by deviceEnvVar if it is usable, else of the best scored one
+size_t SelectDevice(const std::vector<Device>& devices,
+    const std::vector<VkSurfaceKHR>& surfaces,
+    uint32_t instanceApiVersion,
+    bool bindlessAvailable);
+
+}
@@ -0,0 +1,361 @@
+#include "HostAllocator.h"
+
+namespace engine::vulkan {
+
+enum class BlockSource: uint8_t {
+    HEAP,
+    COMMAND_ARENA,
+    OBJECT_ARENA
+};
+
+// Stored directly in front of every pointer handed to the driver, since
+// pfnFree only gets the pointer back.
+struct alignas(16) BlockHeader {
+    void*           block;
+    uint32_t        size;
+    uint8_t         scope;
+    BlockSource     source;
+    uint8_t         sizeClass;
+};
+
+static const size_t commandArenaCapacity = 256 * 1024;
+static const size_t objectArenaChunkSize = 64 * 1024;
+
+static uintptr_t AlignUp(uintptr_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+}
+
+HostScopeStats HostAllocationStats::GetTotal() const {
+    HostScopeStats total {};
+
+    for (const auto& s: scopes) {
+        total.allocations += s.allocations;
+        total.reallocations += s.reallocations;
+        total.frees += s.frees;
+        total.arenaAllocations += s.arenaAllocations;
+        total.totalBytes += s.totalBytes;
+        total.currentBytes += s.currentBytes;
+        total.peakBytes += s.peakBytes;     //upper bound, scope peaks need not coincide
+        total.internalBytes += s.internalBytes;
+    }
+    return total;
+}
+
+const char* GetScopeName(VkSystemAllocationScope scope) {
+    switch (scope) {
+    case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND:    return "command";
+    case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT:     return "object";
+    case VK_SYSTEM_ALLOCATION_SCOPE_CACHE:      return "cache";
+    case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE:     return "device";
+    case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE:   return "instance";
+    default:                                    return "unknown";
+    }
+}
+
+CommandArena::CommandArena(size_t capacity_):
+    memory { static_cast<uint8_t*>(std::malloc(capacity_)) },
+    capacity { memory != nullptr ? capacity_ : 0 },
+    offset { 0 },
+    liveCount { 0 } {
+}
+
+CommandArena::~CommandArena() {
+    std::free(memory);
+}
+
+void* CommandArena::Allocate(size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    size_t start = AlignUp(offset, alignof(BlockHeader));
+    if (start + size > capacity) {
+        return nullptr;
+    }
+    offset = start + size;
+    liveCount++;
+    return memory + start;
+}
+
+void CommandArena::Free() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (--liveCount == 0) {
+        offset = 0;
+    }
+}
+
+ObjectArena::ObjectArena(size_t chunkSize_):
+    chunkSize { chunkSize_ } {
+
+    freeLists.fill(nullptr);
+    chunkCursor.fill(nullptr);
+    chunkEnd.fill(nullptr);
+}
+
+ObjectArena::~ObjectArena() {
+    for (auto chunk: chunks) {
+        std::free(chunk);
+    }
+}
+
+void* ObjectArena::Allocate(size_t size, uint8_t& sizeClass) {
+    size_t classSize = minClassSize;
+    uint8_t cls = 0;
+
+    while (classSize < size) {
+        classSize <<= 1;
+        cls++;
+    }
+    if (cls >= classCount) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    sizeClass = cls;
+    if (freeLists[cls] != nullptr) {
+        FreeBlock* block = freeLists[cls];
+        freeLists[cls] = block->next;
+        return block;
+    }
+
+    if (chunkCursor[cls] == nullptr || chunkCursor[cls] + classSize > chunkEnd[cls]) {
+        uint8_t* chunk = static_cast<uint8_t*>(std::malloc(chunkSize));
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+        chunks.push_back(chunk);
+        chunkCursor[cls] = chunk;
+        chunkEnd[cls] = chunk + chunkSize;
+    }
+
+    void* block = chunkCursor[cls];
+    chunkCursor[cls] += classSize;
+    return block;
+}
+
+void ObjectArena::Free(void* block, uint8_t sizeClass) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = freeLists[sizeClass];
+    freeLists[sizeClass] = freeBlock;
+}
+
+HostAllocator::HostAllocator():
+    callbacks {},
+    commandArena { commandArenaCapacity },
+    objectArena { objectArenaChunkSize } {
+
+    for (auto& c: counters) {
+        c.allocations = 0;
+        c.reallocations = 0;
+        c.frees = 0;
+        c.arenaAllocations = 0;
+        c.totalBytes = 0;
+        c.currentBytes = 0;
+        c.peakBytes = 0;
+        c.internalBytes = 0;
+    }
+
+    callbacks.pUserData = this;
+    callbacks.pfnAllocation = AllocationCallback;
+    callbacks.pfnReallocation = ReallocationCallback;
+    callbacks.pfnFree = FreeCallback;
+    callbacks.pfnInternalAllocation = InternalAllocationCallback;
+    callbacks.pfnInternalFree = InternalFreeCallback;
+}
+
+HostAllocator::~HostAllocator() {
+    HostScopeStats total { GetStats().GetTotal() };
+    if (total.currentBytes > 0) {
+        LOG_WARN(MEMORY, FORMAT("Host allocator destroyed with %llu bytes still allocated",
+            static_cast<unsigned long long>(total.currentBytes)));
+    }
+}
+
+HostAllocationStats HostAllocator::GetStats() const {
+    HostAllocationStats stats {};
+
+    for (size_t i = 0; i < hostAllocationScopeCount; i++) {
+        const ScopeCounters& c = counters[i];
+        HostScopeStats& s = stats.scopes[i];
+
+        s.allocations = c.allocations.load(std::memory_order_relaxed);
+        s.reallocations = c.reallocations.load(std::memory_order_relaxed);
+        s.frees = c.frees.load(std::memory_order_relaxed);
+        s.arenaAllocations = c.arenaAllocations.load(std::memory_order_relaxed);
+        s.totalBytes = c.totalBytes.load(std::memory_order_relaxed);
+        s.currentBytes = c.currentBytes.load(std::memory_order_relaxed);
+        s.peakBytes = c.peakBytes.load(std::memory_order_relaxed);
+        s.internalBytes = c.internalBytes.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void HostAllocator::LogStats() const {
+    HostAllocationStats stats { GetStats() };
+
+    for (size_t i = 0; i < hostAllocationScopeCount; i++) {
+        const HostScopeStats& s = stats.scopes[i];
+        if (s.allocations == 0 && s.internalBytes == 0) {
+            continue;
+        }
+        LOG_INFO(MEMORY, FORMAT("Host memory, %s scope: %llu allocs (%llu arena), %llu reallocs, %llu frees, %llu bytes total, %llu bytes peak, %llu bytes internal",
+            GetScopeName(static_cast<VkSystemAllocationScope>(i)),
+            static_cast<unsigned long long>(s.allocations),
+            static_cast<unsigned long long>(s.arenaAllocations),
+            static_cast<unsigned long long>(s.reallocations),
+            static_cast<unsigned long long>(s.frees),
+            static_cast<unsigned long long>(s.totalBytes),
+            static_cast<unsigned long long>(s.peakBytes),
+            static_cast<unsigned long long>(s.internalBytes)));
+    }
+}
+
+void HostAllocator::AddLiveBytes(ScopeCounters& scopeCounters, size_t size) {
+    uint64_t current = scopeCounters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = scopeCounters.peakBytes.load(std::memory_order_relaxed);
+
+    while (current > peak &&
+           !scopeCounters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+    scopeCounters.totalBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void* HostAllocator::AllocateBlock(size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    if (size == 0 || size > std::numeric_limits<uint32_t>::max()) {
+        return nullptr;
+    }
+    alignment = std::max(alignment, alignof(BlockHeader));
+
+    size_t blockSize = size + sizeof(BlockHeader) + alignment - alignof(BlockHeader);
+    void* block = nullptr;
+    BlockSource source = BlockSource::HEAP;
+    uint8_t sizeClass = 0;
+
+    if (scope == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND) {
+        block = commandArena.Allocate(blockSize);
+        source = BlockSource::COMMAND_ARENA;
+    }
+    else if (scope == VK_SYSTEM_ALLOCATION_SCOPE_OBJECT && blockSize <= ObjectArena::maxClassSize) {
+        block = objectArena.Allocate(blockSize, sizeClass);
+        source = BlockSource::OBJECT_ARENA;
+    }
+
+    if (block == nullptr) {
+        block = std::malloc(blockSize);
+        source = BlockSource::HEAP;
+        if (block == nullptr) {
+            return nullptr;
+        }
+    }
+    else {
+        counters[scope].arenaAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uintptr_t user = AlignUp(reinterpret_cast<uintptr_t>(block) + sizeof(BlockHeader), alignment);
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(user) - 1;
+    header->block = block;
+    header->size = static_cast<uint32_t>(size);
+    header->scope = static_cast<uint8_t>(scope);
+    header->source = source;
+    header->sizeClass = sizeClass;
+
+    AddLiveBytes(counters[scope], size);
+    return reinterpret_cast<void*>(user);
+}
+
+size_t HostAllocator::ReleaseBlock(void* memory, VkSystemAllocationScope& scope) {
+    BlockHeader* header = static_cast<BlockHeader*>(memory) - 1;
+    size_t size = header->size;
+
+    scope = static_cast<VkSystemAllocationScope>(header->scope);
+    counters[scope].currentBytes.fetch_sub(size, std::memory_order_relaxed);
+
+    switch (header->source) {
+    case BlockSource::COMMAND_ARENA:    commandArena.Free();                                break;
+    case BlockSource::OBJECT_ARENA:     objectArena.Free(header->block, header->sizeClass); break;
+    case BlockSource::HEAP:             std::free(header->block);                           break;
+    }
+    return size;
+}
+
+void* HostAllocator::Allocate(size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    void* memory = AllocateBlock(size, alignment, scope);
+
+    if (memory != nullptr) {
+        counters[scope].allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return memory;
+}
+
+void* HostAllocator::Reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    if (original == nullptr) {
+        return Allocate(size, alignment, scope);
+    }
+    if (size == 0) {
+        Free(original);
+        return nullptr;
+    }
+
+    void* memory = AllocateBlock(size, alignment, scope);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+
+    size_t oldSize = (static_cast<BlockHeader*>(original) - 1)->size;
+    std::memcpy(memory, original, std::min(oldSize, size));
+
+    VkSystemAllocationScope oldScope;
+    ReleaseBlock(original, oldScope);
+    counters[scope].reallocations.fetch_add(1, std::memory_order_relaxed);
+    return memory;
+}
+
+void HostAllocator::Free(void* memory) {
+    if (memory == nullptr) {
+        return;
+    }
+    VkSystemAllocationScope scope;
+    ReleaseBlock(memory, scope);
+    counters[scope].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+VKAPI_ATTR void* VKAPI_CALL HostAllocator::AllocationCallback(void* userData,
+    size_t size,
+    size_t alignment,
+    VkSystemAllocationScope scope) {
+
+    return static_cast<HostAllocator*>(userData)->Allocate(size, alignment, scope);
+}
+
+VKAPI_ATTR void* VKAPI_CALL HostAllocator::ReallocationCallback(void* userData,
+    void* original,
+    size_t size,
+    size_t alignment,
+    VkSystemAllocationScope scope) {
+
+    return static_cast<HostAllocator*>(userData)->Reallocate(original, size, alignment, scope);
+}
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::FreeCallback(void* userData, void* memory) {
+    static_cast<HostAllocator*>(userData)->Free(memory);
+}
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::InternalAllocationCallback(void* userData,
+    size_t size,
+    VkInternalAllocationType type,
+    VkSystemAllocationScope scope) {
+
+    static_cast<HostAllocator*>(userData)->counters[scope].internalBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::InternalFreeCallback(void* userData,
+    size_t size,
+    VkInternalAllocationType type,
+    VkSystemAllocationScope scope) {
+
+    static_cast<HostAllocator*>(userData)->counters[scope].internalBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+
+namespace engine::vulkan {
+
+// VK_SYSTEM_ALLOCATION_SCOPE_RANGE_SIZE is gone from newer headers
+const size_t hostAllocationScopeCount = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+struct HostScopeStats {
+    uint64_t    allocations;
+    uint64_t    reallocations;
+    uint64_t    frees;
+    uint64_t    arenaAllocations;
+    uint64_t    totalBytes;
+    uint64_t    currentBytes;
+    uint64_t    peakBytes;
+    uint64_t    internalBytes;
+};
+
+struct HostAllocationStats {
+    std::array<HostScopeStats, hostAllocationScopeCount>    scopes;
+
+    HostScopeStats          GetTotal() const;
+};
+
+const char* GetScopeName(VkSystemAllocationScope scope);
+
+// Bump arena for command scope allocations, which only live for the duration
+// of a single vk* call. Rewinds once every outstanding block has been freed.
+class CommandArena {
+
+public:
+    explicit                CommandArena(size_t capacity_);
+                            ~CommandArena();
+
+    void*                   Allocate(size_t size);
+    void                    Free();
+
+private:
+    std::mutex              mutex;
+    uint8_t*                memory;
+    size_t                  capacity;
+    size_t                  offset;
+    size_t                  liveCount;
+};
+
+// Segregated free lists for small object scope allocations, carved from
+// larger chunks so drivers creating many tiny objects don't hit malloc.
+class ObjectArena {
+
+public:
+    static const size_t     classCount = 6;
+    static const size_t     minClassSize = 32;
+    static const size_t     maxClassSize = minClassSize << (classCount - 1);
+
+    explicit                ObjectArena(size_t chunkSize_);
+                            ~ObjectArena();
+
+    void*                   Allocate(size_t size, uint8_t& sizeClass);
+    void                    Free(void* block, uint8_t sizeClass);
+
+private:
+    struct FreeBlock {
+        FreeBlock*          next;
+    };
+
+    std::mutex                              mutex;
+    size_t                                  chunkSize;
+    std::vector<uint8_t*>                   chunks;
+    std::array<FreeBlock*, classCount>      freeLists;
+    std::array<uint8_t*, classCount>        chunkCursor;
+    std::array<uint8_t*, classCount>        chunkEnd;
+};
+
+class HostAllocator {
+
+public:
+                                    HostAllocator();
+                                    HostAllocator(const HostAllocator&) = delete;
+                                    ~HostAllocator();
+
+    const VkAllocationCallbacks*    GetCallbacks() const { return &callbacks; }
+    HostAllocationStats             GetStats() const;
+    void                            LogStats() const;
+
+private:
+    struct ScopeCounters {
+        std::atomic<uint64_t>       allocations;
+        std::atomic<uint64_t>       reallocations;
+        std::atomic<uint64_t>       frees;
+        std::atomic<uint64_t>       arenaAllocations;
+        std::atomic<uint64_t>       totalBytes;
+        std::atomic<uint64_t>       currentBytes;
+        std::atomic<uint64_t>       peakBytes;
+        std::atomic<uint64_t>       internalBytes;
+    };
+
+    VkAllocationCallbacks                                   callbacks;
+    CommandArena                                            commandArena;
+    ObjectArena                                             objectArena;
+    std::array<ScopeCounters, hostAllocationScopeCount>     counters;
+
+    void*                   Allocate(size_t size, size_t alignment, VkSystemAllocationScope scope);
+    void*                   Reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+    void                    Free(void* memory);
+    void*                   AllocateBlock(size_t size, size_t alignment, VkSystemAllocationScope scope);
+    size_t                  ReleaseBlock(void* memory, VkSystemAllocationScope& scope);
+    void                    AddLiveBytes(ScopeCounters& scopeCounters, size_t size);
+
+    static VKAPI_ATTR void* VKAPI_CALL AllocationCallback(void* userData,
+                                        size_t size,
+                                        size_t alignment,
+                                        VkSystemAllocationScope scope);
+    static VKAPI_ATTR void* VKAPI_CALL ReallocationCallback(void* userData,
+                                        void* original,
+                                        size_t size,
+                                        size_t alignment,
+                                        VkSystemAllocationScope scope);
+    static VKAPI_ATTR void VKAPI_CALL  FreeCallback(void* userData, void* memory);
+    static VKAPI_ATTR void VKAPI_CALL  InternalAllocationCallback(void* userData,
+                                        size_t size,
+                                        VkInternalAllocationType type,
+                                        VkSystemAllocationScope scope);
+    static VKAPI_ATTR void VKAPI_CALL  InternalFreeCallback(void* userData,
+                                        size_t size,
+                                        VkInternalAllocationType type,
+                                        VkSystemAllocationScope scope);
+};
+
+}
@@ -11,15 +11,17 @@ static VkPipelineShaderStageCreateInfo CreateVertexShaderStageInfo(VkShaderModul
 static VkPipelineShaderStageCreateInfo CreateFragmentShaderStageInfo(VkShaderModule module);
 static VkPipelineVertexInputStateCreateInfo CreateVertexInputStateInfo();
 static VkPipelineInputAssemblyStateCreateInfo CreateInputAssemblyStateInfo();
-static VkViewport CreateViewport(VkExtent2D swapChainExtent);
-static VkRect2D CreaterScissorRect(VkExtent2D swapChainExtent);
-static VkPipelineViewportStateCreateInfo CreateViewportStateInfo(VkViewport* viewport, VkRect2D* scissor);
+static VkPipelineViewportStateCreateInfo CreateViewportStateInfo();
 static VkPipelineRasterizationStateCreateInfo CreateRasterizerStateInfo();
 static VkPipelineMultisampleStateCreateInfo CreateMultisampleStateInfo();
 static VkPipelineColorBlendAttachmentState CreateColorBlendAttachInfo();
 static VkPipelineColorBlendStateCreateInfo CreateColorBlendStateInfo(VkPipelineColorBlendAttachmentState* attachInfo);
-//static VkPipelineDynamicStateCreateInfo CreateDynamicStateInfo(VkDynamicState* dynamicStates, size_t dsCount);
-static VkPipelineLayoutCreateInfo CreatePipelineLayoutInfo();
+static VkPipelineDynamicStateCreateInfo CreateDynamicStateInfo(const VkDynamicState* dynamicStates, size_t dsCount);
+static VkPipelineLayoutCreateInfo CreatePipelineLayoutInfo(const VkDescriptorSetLayout* setLayouts,
+    uint32_t setLayoutCount,
+    const VkPushConstantRange* pushConstantRanges,
+    uint32_t pushConstantRangeCount);
+static VkDescriptorSetLayoutBinding CreateDrawUniformBinding();
 static VkGraphicsPipelineCreateInfo CreatePipelineInfo(VkPipelineShaderStageCreateInfo* shaderStageInfos,
     VkPipelineVertexInputStateCreateInfo* vertexInputInfo,
     VkPipelineInputAssemblyStateCreateInfo* inputAssemblyInfo,
@@ -27,16 +29,23 @@ static VkGraphicsPipelineCreateInfo CreatePipelineInfo(VkPipelineShaderStageCrea
     VkPipelineRasterizationStateCreateInfo* rasterStateInfo,
     VkPipelineMultisampleStateCreateInfo* multisampleStateInfo,
     VkPipelineColorBlendStateCreateInfo* blendStateInfo,
+    VkPipelineDynamicStateCreateInfo* dynamicStateInfo,
     VkPipelineLayout layout,
     VkRenderPass renderPass);
 
-Pipeline::Pipeline(const VkDevice device_, VkExtent2D swapChainExtent, VkSurfaceFormatKHR swapChainFormat):
+// Viewport and scissor are set per command buffer, so a resize keeps the pipeline
+static const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+Pipeline::Pipeline(const VkDevice device_, const VkAllocationCallbacks* allocator_, VkSurfaceFormatKHR swapChainFormat, VkDescriptorSetLayout bindlessLayout, const AssetArchive* assets):
     device { device_ },
+    allocator { allocator_ },
     renderPass { VK_NULL_HANDLE },
+    drawSetLayout { VK_NULL_HANDLE },
     layout { VK_NULL_HANDLE },
     pipeline { VK_NULL_HANDLE },
-    vertexShader { device, "vert.spv" },
-    fragmentShader { device, "frag.spv" } {
+    bindless { bindlessLayout != VK_NULL_HANDLE },
+    vertexShader { device, allocator, assets, "shader.vert.spv" },
+    fragmentShader { device, allocator, assets, bindless ? "bindless.frag.spv" : "shader.frag.spv" } {
 
     VkAttachmentDescription attachDescr { CreateAttachmentDescription(swapChainFormat) };
     VkAttachmentReference attachRef { CreateAttachmentReference() };
@@ -44,22 +53,26 @@ Pipeline::Pipeline(const VkDevice device_, VkExtent2D swapChainExtent, VkSurface
     VkSubpassDependency subpassDependency { CreateSubpassDependency() };
 
     LoadRenderPass(&attachDescr, &subpassDescr, &subpassDependency);
+    LoadDrawSetLayout();
+    LoadPushConstants();
 
     VkPipelineShaderStageCreateInfo vertShaderStageInfo { CreateVertexShaderStageInfo(vertexShader.GetModule()) };
     VkPipelineShaderStageCreateInfo fragShaderStageInfo { CreateFragmentShaderStageInfo(fragmentShader.GetModule()) };
     VkPipelineVertexInputStateCreateInfo vertInputInfo { CreateVertexInputStateInfo() };
     VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo { CreateInputAssemblyStateInfo() };
-    VkViewport viewport { CreateViewport(swapChainExtent) };
-    VkRect2D scissorRect { CreaterScissorRect(swapChainExtent) };
-    VkPipelineViewportStateCreateInfo viewportInfo { CreateViewportStateInfo(&viewport, &scissorRect) };
+    VkPipelineViewportStateCreateInfo viewportInfo { CreateViewportStateInfo() };
     VkPipelineRasterizationStateCreateInfo rasterInfo { CreateRasterizerStateInfo() };
     VkPipelineMultisampleStateCreateInfo multisampleInfo { CreateMultisampleStateInfo() };
     VkPipelineColorBlendAttachmentState blendAttachInfo { CreateColorBlendAttachInfo() };
     VkPipelineColorBlendStateCreateInfo blendInfo { CreateColorBlendStateInfo(&blendAttachInfo) };
-    //VkPipelineDynamicStateCreateInfo dynamicStateInfo { CreateDynamicStateInfo(nullptr, 0) };
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo { CreatePipelineLayoutInfo() };
-
-    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &layout) != VK_SUCCESS) {
+    VkPipelineDynamicStateCreateInfo dynamicStateInfo { CreateDynamicStateInfo(dynamicStates, 2) };
+    VkDescriptorSetLayout setLayouts[] = { drawSetLayout, bindlessLayout };
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo { CreatePipelineLayoutInfo(setLayouts,
+        bindless ? 2 : 1,
+        pushConstants.GetRanges(),
+        pushConstants.GetRangeCount()) };
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, allocator, &layout) != VK_SUCCESS) {
         throw std::runtime_error("Could not create pipeline layout");
     }
     VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
@@ -71,29 +84,35 @@ Pipeline::Pipeline(const VkDevice device_, VkExtent2D swapChainExtent, VkSurface
         &rasterInfo,
         &multisampleInfo,
         &blendInfo,
+        &dynamicStateInfo,
         layout,
         renderPass) };
 
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    TRACE_SCOPE("vkCreateGraphicsPipelines");
+    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, allocator, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("Could not create graphics pipeline");
     }
-    INFO("Created graphics pipeline");
+    LOG_INFO(PIPELINE, "Created graphics pipeline");
 
 }
 
 Pipeline::~Pipeline() {
 
     if (pipeline != VK_NULL_HANDLE) {
-        vkDestroyPipeline(device, pipeline, nullptr);
-        INFO("Destroyed graphics pipeline");
+        vkDestroyPipeline(device, pipeline, allocator);
+        LOG_INFO(PIPELINE, "Destroyed graphics pipeline");
     }
 
     if (layout != VK_NULL_HANDLE) {
-        vkDestroyPipelineLayout(device, layout, nullptr);
+        vkDestroyPipelineLayout(device, layout, allocator);
+    }
+
+    if (drawSetLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(device, drawSetLayout, allocator);
     }
 
     if (renderPass != VK_NULL_HANDLE) {
-        vkDestroyRenderPass(device, renderPass, nullptr);
+        vkDestroyRenderPass(device, renderPass, allocator);
     }
 
 }
@@ -101,11 +120,33 @@ Pipeline::~Pipeline() {
 void Pipeline::LoadRenderPass(VkAttachmentDescription* attachDescr, VkSubpassDescription* subpassDescr, VkSubpassDependency* subpassDependency) {
     VkRenderPassCreateInfo createInfo { CreateRenderPassInfo(attachDescr, subpassDescr, subpassDependency) };
 
-    if (vkCreateRenderPass(device, &createInfo, nullptr, &renderPass) != VK_SUCCESS) {
+    if (vkCreateRenderPass(device, &createInfo, allocator, &renderPass) != VK_SUCCESS) {
         throw std::runtime_error("Could not create render pass");
     }
 }
 
+void Pipeline::LoadDrawSetLayout() {
+    VkDescriptorSetLayoutBinding binding { CreateDrawUniformBinding() };
+    VkDescriptorSetLayoutCreateInfo createInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    createInfo.bindingCount = 1;
+    createInfo.pBindings = &binding;
+
+    if (vkCreateDescriptorSetLayout(device, &createInfo, allocator, &drawSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create draw descriptor set layout");
+    }
+}
+
+void Pipeline::LoadPushConstants() {
+    pushConstants.AddRange(VK_SHADER_STAGE_VERTEX_BIT,
+        offsetof(DrawPushConstants, offset),
+        offsetof(DrawPushConstants, indices));
+    pushConstants.AddRange(VK_SHADER_STAGE_FRAGMENT_BIT,
+        offsetof(DrawPushConstants, indices),
+        sizeof(BindlessIndices));
+}
+
 static VkAttachmentDescription CreateAttachmentDescription(VkSurfaceFormatKHR imageFormat) {
     VkAttachmentDescription attachDescr {};
 
@@ -216,36 +257,14 @@ static VkPipelineInputAssemblyStateCreateInfo CreateInputAssemblyStateInfo() {
     return createInfo;
 }
 
-static VkViewport CreateViewport(VkExtent2D swapChainExtent) {
-    VkViewport viewport {};
-
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(swapChainExtent.width);
-    viewport.height = static_cast<float>(swapChainExtent.height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    return viewport;
-}
-
-static VkRect2D CreaterScissorRect(VkExtent2D swapChainExtent) {
-    VkRect2D scissor {};
-
-    scissor.offset = { 0, 0 };
-    scissor.extent = swapChainExtent;
-
-    return scissor;
-}
-
-static VkPipelineViewportStateCreateInfo CreateViewportStateInfo(VkViewport* viewport, VkRect2D* scissor) {
+static VkPipelineViewportStateCreateInfo CreateViewportStateInfo() {
     VkPipelineViewportStateCreateInfo createInfo {};
 
     createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     createInfo.viewportCount = 1;
-    createInfo.pViewports = viewport;
+    createInfo.pViewports = nullptr;
     createInfo.scissorCount = 1;
-    createInfo.pScissors = scissor;
+    createInfo.pScissors = nullptr;
 
     return createInfo;
 }
@@ -318,28 +337,43 @@ static VkPipelineColorBlendStateCreateInfo CreateColorBlendStateInfo(VkPipelineC
     return createInfo;
 }
 
-/*static VkPipelineDynamicStateCreateInfo CreateDynamicStateInfo(VkDynamicState* dynamicStates, size_t dsCount) {
+static VkPipelineDynamicStateCreateInfo CreateDynamicStateInfo(const VkDynamicState* dynamicStates, size_t dsCount) {
     VkPipelineDynamicStateCreateInfo createInfo {};
 
     createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    createInfo.dynamicStateCount = dsCount;
+    createInfo.dynamicStateCount = static_cast<uint32_t>(dsCount);
     createInfo.pDynamicStates = dynamicStates;
 
     return createInfo;
-}*/
+}
 
-static VkPipelineLayoutCreateInfo CreatePipelineLayoutInfo() {
+static VkPipelineLayoutCreateInfo CreatePipelineLayoutInfo(const VkDescriptorSetLayout* setLayouts,
+    uint32_t setLayoutCount,
+    const VkPushConstantRange* pushConstantRanges,
+    uint32_t pushConstantRangeCount) {
     VkPipelineLayoutCreateInfo createInfo {};
 
     createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    createInfo.setLayoutCount = 0;
-    createInfo.pSetLayouts = nullptr;
-    createInfo.pushConstantRangeCount = 0;
-    createInfo.pPushConstantRanges = nullptr;
+    createInfo.setLayoutCount = setLayoutCount;
+    createInfo.pSetLayouts = setLayouts;
+    createInfo.pushConstantRangeCount = pushConstantRangeCount;
+    createInfo.pPushConstantRanges = pushConstantRanges;
 
     return createInfo;
 }
 
+static VkDescriptorSetLayoutBinding CreateDrawUniformBinding() {
+    VkDescriptorSetLayoutBinding binding {};
+
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    binding.pImmutableSamplers = nullptr;
+
+    return binding;
+}
+
 static VkGraphicsPipelineCreateInfo CreatePipelineInfo(VkPipelineShaderStageCreateInfo* shaderStageInfos,
     VkPipelineVertexInputStateCreateInfo* vertexInputInfo,
     VkPipelineInputAssemblyStateCreateInfo* inputAssemblyInfo,
@@ -347,6 +381,7 @@ static VkGraphicsPipelineCreateInfo CreatePipelineInfo(VkPipelineShaderStageCrea
     VkPipelineRasterizationStateCreateInfo* rasterStateInfo,
     VkPipelineMultisampleStateCreateInfo* multisampleStateInfo,
     VkPipelineColorBlendStateCreateInfo* blendStateInfo,
+    VkPipelineDynamicStateCreateInfo* dynamicStateInfo,
     VkPipelineLayout layout,
     VkRenderPass renderPass) {
 
@@ -362,7 +397,7 @@ static VkGraphicsPipelineCreateInfo CreatePipelineInfo(VkPipelineShaderStageCrea
     createInfo.pMultisampleState = multisampleStateInfo;
     createInfo.pDepthStencilState = nullptr;
     createInfo.pColorBlendState = blendStateInfo;
-    createInfo.pDynamicState = nullptr;
+    createInfo.pDynamicState = dynamicStateInfo;
 
     createInfo.layout = layout;
     createInfo.renderPass = renderPass;
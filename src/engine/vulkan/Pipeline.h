@@ -4,25 +4,44 @@
 
 #include "logging/StdLogger.h"
 #include "Shader.h"
+#include "BindlessTable.h"
+#include "PushConstants.h"
 
 namespace engine::vulkan {
 
+// Mirrors the DrawUniforms block in shader.vert, one per draw in the uniform ring
+struct DrawUniforms {
+    float       color[4];
+};
+
 class Pipeline {
 
 public:
+    static const uint32_t   drawSetIndex = 0;
+    static const uint32_t   bindlessSetIndex = 1;
 
                             Pipeline(const VkDevice device_,
-                                VkExtent2D swapChainExtent,
-                                VkSurfaceFormatKHR swapChainFormat);
+                                const VkAllocationCallbacks* allocator_,
+                                VkSurfaceFormatKHR swapChainFormat,
+                                VkDescriptorSetLayout bindlessLayout,
+                                const AssetArchive* assets);
                             ~Pipeline();
     VkRenderPass            GetRenderPass() const { return renderPass; }
     VkPipeline              GetPipeline() const { return pipeline; }
+    VkPipelineLayout        GetLayout() const { return layout; }
+    VkDescriptorSetLayout   GetDrawSetLayout() const { return drawSetLayout; }
+    const PushConstantLayout& GetPushConstants() const { return pushConstants; }
+    bool                    IsBindless() const { return bindless; }
 
 private:
     const VkDevice          device;
+    const VkAllocationCallbacks* allocator;
     VkRenderPass            renderPass;
+    VkDescriptorSetLayout   drawSetLayout;
     VkPipelineLayout        layout;
+    PushConstantLayout      pushConstants;
     VkPipeline              pipeline;
+    bool                    bindless;
 
     Shader                  vertexShader;
     Shader                  fragmentShader;
@@ -30,7 +49,8 @@ private:
 
 
     void                    LoadRenderPass(VkAttachmentDescription* attachDescr, VkSubpassDescription* subpassDescr, VkSubpassDependency* subpassDependency);
-    void                    LoadLayout();
+    void                    LoadDrawSetLayout();
+    void                    LoadPushConstants();
 
 
 };
@@ -0,0 +1,145 @@
+#include "PresentTransfer.h"
+
+namespace engine::vulkan {
+
+PresentTransfer::PresentTransfer(const Device& device_, const VkAllocationCallbacks* allocator_, const SwapChain& swapchain):
+    device { device_.GetLogicalDevice() },
+    allocator { allocator_ },
+    presentQueue { device_.GetPresentQueue().GetQueue() },
+    graphicsFamily { static_cast<uint32_t>(device_.GetGraphicsQueue().GetIndex()) },
+    presentFamily { static_cast<uint32_t>(device_.GetPresentQueue().GetIndex()) },
+    pool { VK_NULL_HANDLE } {
+
+    for (size_t i = 0; i < swapchain.GetImageCount(); i++) {
+        images.push_back(swapchain.GetImage(i));
+    }
+    LoadPool();
+    LoadAcquireBuffers();
+    LoadSemaphores();
+    LOG_DEBUG(SWAPCHAIN, FORMAT("Created present transfer from queue family %u to %u", graphicsFamily, presentFamily));
+}
+
+PresentTransfer::~PresentTransfer() {
+    for (auto semaphore: acquiredSems) {
+        vkDestroySemaphore(device, semaphore, allocator);
+    }
+    if (acquireBuffers.size() > 0) {
+        vkFreeCommandBuffers(device, pool, acquireBuffers.size(), acquireBuffers.data());
+    }
+    if (pool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device, pool, allocator);
+    }
+    LOG_DEBUG(SWAPCHAIN, "Destroyed present transfer");
+}
+
+VkImageMemoryBarrier PresentTransfer::CreateBarrier(uint32_t imageIndex) const {
+    VkImageMemoryBarrier barrier {};
+
+    // the render pass already left the image in present layout, only the owner changes
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.srcQueueFamilyIndex = graphicsFamily;
+    barrier.dstQueueFamilyIndex = presentFamily;
+    barrier.image = images[imageIndex];
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    return barrier;
+}
+
+void PresentTransfer::LoadPool() {
+    VkCommandPoolCreateInfo createInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    createInfo.queueFamilyIndex = presentFamily;
+
+    if (vkCreateCommandPool(device, &createInfo, allocator, &pool) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create present transfer command pool");
+    }
+}
+
+void PresentTransfer::LoadAcquireBuffers() {
+    VkCommandBufferAllocateInfo allocInfo {};
+
+    acquireBuffers.resize(images.size(), VK_NULL_HANDLE);
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = pool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = static_cast<uint32_t>(acquireBuffers.size());
+
+    if (vkAllocateCommandBuffers(device, &allocInfo, acquireBuffers.data()) != VK_SUCCESS) {
+        throw std::runtime_error("Could not allocate present transfer command buffers");
+    }
+
+    // the barrier only depends on the image, so every buffer is recorded once and reused
+    for (uint32_t i = 0; i < acquireBuffers.size(); i++) {
+        VkCommandBufferBeginInfo beginInfo {};
+        VkImageMemoryBarrier barrier { CreateBarrier(i) };
+
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+
+        vkBeginCommandBuffer(acquireBuffers[i], &beginInfo);
+        vkCmdPipelineBarrier(acquireBuffers[i],
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0,
+            0, nullptr,
+            0, nullptr,
+            1, &barrier);
+        if (vkEndCommandBuffer(acquireBuffers[i]) != VK_SUCCESS) {
+            throw std::runtime_error("Could not record present transfer command buffer");
+        }
+    }
+}
+
+void PresentTransfer::LoadSemaphores() {
+    VkSemaphoreCreateInfo createInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    acquiredSems.resize(images.size(), VK_NULL_HANDLE);
+
+    // one per image, an image is not acquired again before its last present waited on it
+    for (auto& semaphore: acquiredSems) {
+        if (vkCreateSemaphore(device, &createInfo, allocator, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("Could not create present transfer semaphore");
+        }
+    }
+}
+
+void PresentTransfer::RecordRelease(VkCommandBuffer commandBuffer, uint32_t imageIndex) const {
+    VkImageMemoryBarrier barrier { CreateBarrier(imageIndex) };
+
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        0,
+        0, nullptr,
+        0, nullptr,
+        1, &barrier);
+}
+
+VkSemaphore PresentTransfer::Submit(uint32_t imageIndex, VkSemaphore renderFinished) {
+    VkSubmitInfo submitInfo {};
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &renderFinished;
+    submitInfo.pWaitDstStageMask = &waitStage;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &acquireBuffers[imageIndex];
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &acquiredSems[imageIndex];
+
+    if (vkQueueSubmit(presentQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("Could not submit present transfer");
+    }
+    return acquiredSems[imageIndex];
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+#include "Device.h"
+#include "SwapChain.h"
+
+namespace engine::vulkan {
+
+// Hands exclusive swapchain images from the graphics to the present family.
+// The frame's command buffer ends with the release barrier, the matching
+// acquire barrier is recorded once per image into command buffers on the
+// present queue, which run between rendering and presentation.
+class PresentTransfer {
+
+public:
+                            PresentTransfer(const Device& device_,
+                                const VkAllocationCallbacks* allocator_,
+                                const SwapChain& swapchain);
+                            ~PresentTransfer();
+
+    void                    RecordRelease(VkCommandBuffer commandBuffer, uint32_t imageIndex) const;
+    // Acquires the image on the present queue once renderFinished is signaled, returns the semaphore to present on
+    VkSemaphore             Submit(uint32_t imageIndex, VkSemaphore renderFinished);
+
+private:
+    VkDevice                        device;
+    const VkAllocationCallbacks*    allocator;
+    VkQueue                         presentQueue;
+    uint32_t                        graphicsFamily;
+    uint32_t                        presentFamily;
+    VkCommandPool                   pool;
+    std::vector<VkImage>            images;
+    std::vector<VkCommandBuffer>    acquireBuffers;
+    std::vector<VkSemaphore>        acquiredSems;
+
+    VkImageMemoryBarrier    CreateBarrier(uint32_t imageIndex) const;
+    void                    LoadPool();
+    void                    LoadAcquireBuffers();
+    void                    LoadSemaphores();
+};
+
+}
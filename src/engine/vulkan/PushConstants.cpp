@@ -0,0 +1,50 @@
+#include "PushConstants.h"
+
+namespace engine::vulkan {
+
+PushConstantLayout::PushConstantLayout():
+    size { 0 } {
+}
+
+void PushConstantLayout::AddRange(VkShaderStageFlags stages, uint32_t offset, uint32_t rangeSize) {
+    if (offset % 4 != 0 || rangeSize % 4 != 0 || rangeSize == 0) {
+        throw std::runtime_error("Push constant ranges must be non-empty multiples of 4 bytes");
+    }
+    for (const auto& range: ranges) {
+        if (offset < range.offset + range.size && range.offset < offset + rangeSize) {
+            throw std::runtime_error("Push constant ranges must not overlap");
+        }
+    }
+    VkPushConstantRange range {};
+
+    range.stageFlags = stages;
+    range.offset = offset;
+    range.size = rangeSize;
+
+    ranges.push_back(range);
+    size = std::max(size, offset + rangeSize);
+}
+
+void PushConstantLayout::PushRange(VkCommandBuffer buffer,
+    VkPipelineLayout layout,
+    uint32_t offset,
+    uint32_t dataSize,
+    const void* data) const {
+
+    if (offset + dataSize > size) {
+        throw std::runtime_error("Push constant write exceeds declared ranges");
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t end = offset + dataSize;
+
+    for (const auto& range: ranges) {
+        uint32_t first = std::max(offset, range.offset);
+        uint32_t last = std::min(end, range.offset + range.size);
+
+        if (first < last) {
+            vkCmdPushConstants(buffer, layout, range.stageFlags, first, last - first, bytes + (first - offset));
+        }
+    }
+}
+
+}
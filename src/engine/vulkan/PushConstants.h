@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+#include <vulkan/vulkan.h>
+
+#include "BindlessTable.h"
+
+namespace engine::vulkan {
+
+// Mirrors the push_constant blocks in shader.vert and bindless.frag.
+// The vertex stage reads the transform, the fragment stage the bindless indices.
+struct DrawPushConstants {
+    float               offset[2];
+    float               scale;
+    BindlessIndices     indices;
+};
+
+// Push constant ranges declared next to the pipeline that uses them.
+// Ranges may not overlap, so every byte belongs to exactly one set of stages
+// and Push can split a write into one vkCmdPushConstants per touched range.
+class PushConstantLayout {
+
+public:
+                            PushConstantLayout();
+
+    void                    AddRange(VkShaderStageFlags stages, uint32_t offset, uint32_t rangeSize);
+    void                    PushRange(VkCommandBuffer buffer,
+                                VkPipelineLayout layout,
+                                uint32_t offset,
+                                uint32_t dataSize,
+                                const void* data) const;
+
+    template<typename T>
+    void                    Push(VkCommandBuffer buffer, VkPipelineLayout layout, const T& value) const;
+    template<typename T>
+    void                    PushField(VkCommandBuffer buffer, VkPipelineLayout layout, uint32_t offset, const T& value) const;
+
+    const VkPushConstantRange*  GetRanges() const { return ranges.data(); }
+    uint32_t                GetRangeCount() const { return static_cast<uint32_t>(ranges.size()); }
+    uint32_t                GetSize() const { return size; }
+
+private:
+    std::vector<VkPushConstantRange>    ranges;
+    uint32_t                            size;
+};
+
+template<typename T>
+void PushConstantLayout::Push(VkCommandBuffer buffer, VkPipelineLayout layout, const T& value) const {
+    PushRange(buffer, layout, 0, sizeof(T), &value);
+}
+
+template<typename T>
+void PushConstantLayout::PushField(VkCommandBuffer buffer, VkPipelineLayout layout, uint32_t offset, const T& value) const {
+    PushRange(buffer, layout, offset, sizeof(T), &value);
+}
+
+}
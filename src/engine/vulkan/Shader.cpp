@@ -2,28 +2,40 @@
 
 namespace engine::vulkan {
 
-Shader::Shader(const VkDevice device_, const std::string& filename):
+Shader::Shader(const VkDevice device_, const VkAllocationCallbacks* allocator_, const AssetArchive* assets, const std::string& name):
     device { device_ },
+    allocator { allocator_ },
     module { VK_NULL_HANDLE } {
 
-    LoadModule(filename);
+    const AssetArchiveEntry* entry = assets != nullptr ? assets->Find(name) : nullptr;
+
+    if (entry != nullptr) {
+        AssetData code { assets->Read(*entry) };
+        LoadModule(code.GetData(), code.GetSize());
+    } else {
+        // loose files are still picked up, so shaders can be iterated on without repacking
+        LOG_DEBUG(PIPELINE, FORMAT("Shader %s not in asset archive, loading file", name));
+        MappedFile code { name, AccessHint::SEQUENTIAL };
+        LoadModule(code.GetData(), code.GetSize());
+    }
 }
 
 Shader::~Shader() {
     if (module != VK_NULL_HANDLE) {
-        vkDestroyShaderModule(device, module, nullptr);
+        vkDestroyShaderModule(device, module, allocator);
     }
 }
 
-void Shader::LoadModule(const std::string& filename) {
-    std::vector<char> code { ReadFile(filename) };
+void Shader::LoadModule(const uint8_t* code, size_t codeSize) {
+    TRACE_SCOPE("Shader::LoadModule");
+    // archive entries and mappings are both suitably aligned, so the SPIR-V words can be handed over without a copy
     VkShaderModuleCreateInfo createInfo {};
 
     createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+    createInfo.codeSize = codeSize;
+    createInfo.pCode = reinterpret_cast<const uint32_t*>(code);
 
-    if (vkCreateShaderModule(device, &createInfo, nullptr, &module) != VK_SUCCESS) {
+    if (vkCreateShaderModule(device, &createInfo, allocator, &module) != VK_SUCCESS) {
         throw std::runtime_error("Could not create shader module");
     }
 }
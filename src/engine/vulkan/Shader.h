@@ -4,7 +4,9 @@
 
 #include <vulkan/vulkan.h>
 
+#include "logging/StdLogger.h"
 #include "utility/File.h"
+#include "utility/AssetArchive.h"
 
 namespace engine::vulkan {
 
@@ -12,18 +14,22 @@ class Shader {
 
 public:
 
-    explicit                        Shader(const VkDevice device_, const std::string& filename);
+    explicit                        Shader(const VkDevice device_,
+                                        const VkAllocationCallbacks* allocator_,
+                                        const AssetArchive* assets,
+                                        const std::string& name);
                                     ~Shader();
     VkShaderModule                  GetModule() const { return module; }
 
 private:
 
     const VkDevice          device;
+    const VkAllocationCallbacks* allocator;
     VkShaderModule          module;
 
 
 
-    void                    LoadModule(const std::string& filename);
+    void                    LoadModule(const uint8_t* code, size_t codeSize);
 
 };
 
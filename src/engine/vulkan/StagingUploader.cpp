@@ -0,0 +1,225 @@
+#include "StagingUploader.h"
+
+namespace engine::vulkan {
+
+static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// covers the texel size of every format and optimalBufferCopyOffsetAlignment in practice
+static const VkDeviceSize stagingAlignment = 16;
+
+StagingUploader::StagingUploader(const Device& device_, const VkAllocationCallbacks* allocator_, VkDeviceSize capacity):
+    device { device_.GetLogicalDevice() },
+    allocator { allocator_ },
+    queue { device_.GetGraphicsQueue().GetQueue() },
+    pool { VK_NULL_HANDLE },
+    buffer { VK_NULL_HANDLE },
+    memory { VK_NULL_HANDLE },
+    mapped { nullptr },
+    coherent { true },
+    atomSize { std::max<VkDeviceSize>(1, device_.GetProperties().limits.nonCoherentAtomSize) },
+    batchSize { AlignUp(capacity / batchCount, std::max(stagingAlignment, atomSize)) },
+    batches {},
+    current { 0 },
+    nextSerial { 1 } {
+
+    LoadPool(device_);
+    LoadBuffer(device_, batchSize * batchCount);
+    LoadBatches();
+    LOG_INFO(MEMORY, FORMAT("Created staging uploader, %llu bytes per batch", static_cast<unsigned long long>(batchSize)));
+}
+
+StagingUploader::~StagingUploader() {
+    for (auto& batch: batches) {
+        if (batch.submitted) {
+            vkWaitForFences(device, 1, &batch.fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        }
+        if (batch.fence != VK_NULL_HANDLE) {
+            vkDestroyFence(device, batch.fence, allocator);
+        }
+    }
+    if (mapped != nullptr) {
+        vkUnmapMemory(device, memory);
+    }
+    if (buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, buffer, allocator);
+    }
+    if (memory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, memory, allocator);
+    }
+    if (pool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device, pool, allocator);
+    }
+    LOG_DEBUG(MEMORY, "Destroyed staging uploader");
+}
+
+void StagingUploader::LoadPool(const Device& device_) {
+    VkCommandPoolCreateInfo createInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    createInfo.queueFamilyIndex = device_.GetGraphicsQueue().GetIndex();
+    createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+    if (vkCreateCommandPool(device, &createInfo, allocator, &pool) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create staging command pool");
+    }
+}
+
+void StagingUploader::LoadBuffer(const Device& device_, VkDeviceSize capacity) {
+    VkBufferCreateInfo createInfo {};
+    VkMemoryRequirements requirements;
+    VkMemoryAllocateInfo allocInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = capacity;
+    createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &createInfo, allocator, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create staging buffer");
+    }
+    vkGetBufferMemoryRequirements(device, buffer, &requirements);
+
+    int memoryType = device_.FindMemoryType(requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (memoryType == -1) {
+        memoryType = device_.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+        coherent = false;
+    }
+    if (memoryType == -1) {
+        throw std::runtime_error("Could not find host visible memory for staging buffer");
+    }
+
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = static_cast<uint32_t>(memoryType);
+
+    if (vkAllocateMemory(device, &allocInfo, allocator, &memory) != VK_SUCCESS) {
+        throw std::runtime_error("Could not allocate staging memory");
+    }
+    vkBindBufferMemory(device, buffer, memory, 0);
+
+    void* data = nullptr;
+    if (vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("Could not map staging memory");
+    }
+    mapped = static_cast<uint8_t*>(data);
+}
+
+void StagingUploader::LoadBatches() {
+    VkCommandBuffer commandBuffers[batchCount];
+    VkCommandBufferAllocateInfo allocInfo {};
+    VkFenceCreateInfo fenceInfo {};
+
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = pool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = batchCount;
+
+    if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers) != VK_SUCCESS) {
+        throw std::runtime_error("Could not allocate staging command buffers");
+    }
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    for (size_t i = 0; i < batchCount; i++) {
+        batches[i].commandBuffer = commandBuffers[i];
+        if (vkCreateFence(device, &fenceInfo, allocator, &batches[i].fence) != VK_SUCCESS) {
+            throw std::runtime_error("Could not create staging fence");
+        }
+    }
+}
+
+void StagingUploader::BeginBatch() {
+    Batch& batch = batches[current];
+    VkCommandBufferBeginInfo beginInfo {};
+
+    // normally long done, the other batch was in between
+    if (batch.submitted) {
+        vkWaitForFences(device, 1, &batch.fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        vkResetFences(device, 1, &batch.fence);
+        batch.submitted = false;
+    }
+    vkResetCommandBuffer(batch.commandBuffer, 0);
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(batch.commandBuffer, &beginInfo);
+
+    batch.serial = nextSerial;
+    batch.head = 0;
+    batch.recording = true;
+}
+
+VkCommandBuffer StagingUploader::GetCommandBuffer() {
+    if (!batches[current].recording) {
+        BeginBatch();
+    }
+    return batches[current].commandBuffer;
+}
+
+VkDeviceSize StagingUploader::GetAvailable() const {
+    const Batch& batch = batches[current];
+    return batch.recording ? batchSize - batch.head : batchSize;
+}
+
+bool StagingUploader::Stage(const void* data, VkDeviceSize size, VkDeviceSize& offset) {
+    if (size > GetAvailable()) {
+        return false;
+    }
+    GetCommandBuffer();
+    Batch& batch = batches[current];
+
+    offset = batchSize * current + batch.head;
+    std::memcpy(mapped + offset, data, size);
+    batch.head = std::min(batchSize, AlignUp(batch.head + size, stagingAlignment));
+    return true;
+}
+
+uint64_t StagingUploader::Submit() {
+    Batch& batch = batches[current];
+    VkSubmitInfo submitInfo {};
+
+    if (!batch.recording) {
+        return nextSerial - 1;
+    }
+    vkEndCommandBuffer(batch.commandBuffer);
+
+    if (!coherent && batch.head > 0) {
+        VkMappedMemoryRange range {};
+
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = memory;
+        // batches start on an atom boundary, so only the staged part needs flushing
+        range.offset = batchSize * current;
+        range.size = std::min(AlignUp(batch.head, atomSize), batchSize);
+        vkFlushMappedMemoryRanges(device, 1, &range);
+    }
+
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &batch.commandBuffer;
+
+    if (vkQueueSubmit(queue, 1, &submitInfo, batch.fence) != VK_SUCCESS) {
+        throw std::runtime_error("Could not submit staging uploads");
+    }
+    batch.recording = false;
+    batch.submitted = true;
+    nextSerial++;
+    current = (current + 1) % batchCount;
+    return batch.serial;
+}
+
+bool StagingUploader::IsComplete(uint64_t serial) {
+    if (serial >= nextSerial) {
+        return false;
+    }
+    for (auto& batch: batches) {
+        // a batch slot only gets reused after its fence was waited for
+        if (batch.serial == serial && batch.submitted) {
+            return vkGetFenceStatus(device, batch.fence) == VK_SUCCESS;
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <cstring>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+#include "Device.h"
+
+namespace engine::vulkan {
+
+// Host visible staging memory plus transfer command buffers on the graphics
+// queue. Data is copied into the current batch's half of the buffer and the
+// copies are recorded into its command buffer, Submit sends the batch off and
+// the next one starts once the other half's previous batch has finished.
+// Submitted before the frame on the same queue, so the frame sees the results.
+class StagingUploader {
+
+public:
+                            StagingUploader(const Device& device_,
+                                const VkAllocationCallbacks* allocator_,
+                                VkDeviceSize capacity);
+                            ~StagingUploader();
+
+    // Copies size bytes into the current batch, false if it does not fit
+    bool                    Stage(const void* data, VkDeviceSize size, VkDeviceSize& offset);
+    VkCommandBuffer         GetCommandBuffer();
+    VkBuffer                GetBuffer() const { return buffer; }
+    VkDeviceSize            GetAvailable() const;
+    VkDeviceSize            GetBatchCapacity() const { return batchSize; }
+
+    // Returns the serial of the submitted batch, a batch with nothing recorded is not submitted
+    uint64_t                Submit();
+    uint64_t                GetCurrentSerial() const { return nextSerial; }
+    bool                    IsComplete(uint64_t serial);
+
+private:
+    static const size_t     batchCount = 2;
+
+    struct Batch {
+        VkCommandBuffer     commandBuffer;
+        VkFence             fence;
+        uint64_t            serial;
+        VkDeviceSize        head;
+        bool                recording;
+        bool                submitted;
+    };
+
+    VkDevice                        device;
+    const VkAllocationCallbacks*    allocator;
+    VkQueue                         queue;
+    VkCommandPool                   pool;
+    VkBuffer                        buffer;
+    VkDeviceMemory                  memory;
+    uint8_t*                        mapped;
+    bool                            coherent;
+    VkDeviceSize                    atomSize;
+    VkDeviceSize                    batchSize;
+    Batch                           batches[batchCount];
+    size_t                          current;
+    uint64_t                        nextSerial;
+
+    void                    LoadPool(const Device& device_);
+    void                    LoadBuffer(const Device& device_, VkDeviceSize capacity);
+    void                    LoadBatches();
+    void                    BeginBatch();
+};
+
+}
@@ -2,71 +2,97 @@
 
 namespace engine::vulkan {
 
-SwapChain::SwapChain(VkPhysicalDevice physicalDevice, const VkDevice logicalDevice_, VkSurfaceKHR surface, int graphicsIndex, int presentIndex):
+SwapChainConfig GetSwapChainPreset(SwapChainPreset preset) {
+    switch (preset) {
+    case SwapChainPreset::LOW_LATENCY:  return SwapChainConfig { { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR }, 0, 1 };
+    case SwapChainPreset::LOW_POWER:    return SwapChainConfig { { VK_PRESENT_MODE_FIFO_KHR }, 2, 1 };
+    case SwapChainPreset::THROUGHPUT:   return SwapChainConfig { { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_KHR }, 3, 2 };
+    default:                            return SwapChainConfig { { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR }, 0, 2 };
+    }
+}
+
+const char* GetPresentModeName(VkPresentModeKHR mode) {
+    switch (mode) {
+    case VK_PRESENT_MODE_IMMEDIATE_KHR:     return "IMMEDIATE";
+    case VK_PRESENT_MODE_MAILBOX_KHR:       return "MAILBOX";
+    case VK_PRESENT_MODE_FIFO_KHR:          return "FIFO";
+    case VK_PRESENT_MODE_FIFO_RELAXED_KHR:  return "FIFO_RELAXED";
+    default:                                return "UNKNOWN";
+    }
+}
+
+VkSurfaceFormatKHR ChooseSurfaceFormat(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface) {
+    uint32_t formatCount;
+    std::vector<VkSurfaceFormatKHR> availableFmts;
+
+    vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, nullptr);
+    if (formatCount != 0) {
+        availableFmts.resize(formatCount);
+        vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, availableFmts.data());
+    }
+
+    if (availableFmts.empty() || (availableFmts.size() == 1 && availableFmts[0].format == VK_FORMAT_UNDEFINED)) {
+        return { VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+    }
+    for (const auto& fmt : availableFmts) {
+        if (fmt.format == VK_FORMAT_B8G8R8A8_UNORM &&
+            fmt.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+            return fmt;
+        }
+    }
+    return availableFmts[0];
+}
+
+SwapChain::SwapChain(VkPhysicalDevice physicalDevice, const VkDevice logicalDevice_, const VkAllocationCallbacks* allocator_, VkSurfaceKHR surface, int graphicsIndex, int presentIndex, bool concurrentSharing, const SwapChainConfig& config, VkExtent2D windowExtent, VkSwapchainKHR oldSwapChain):
     swapChain { VK_NULL_HANDLE },
-    logicalDevice { logicalDevice_ } {
+    logicalDevice { logicalDevice_ },
+    allocator { allocator_ } {
 
+    TRACE_SCOPE("SwapChain::SwapChain");
     LoadSurfaceFormat(physicalDevice, surface);
-    LoadPresentMode(physicalDevice, surface);
-    LoadSwapExent(physicalDevice, surface, 800, 600);
-    LoadSwapChain(physicalDevice, surface, graphicsIndex, presentIndex);
+    LoadPresentMode(physicalDevice, surface, config.presentModes);
+    LoadSwapExent(physicalDevice, surface, windowExtent.width, windowExtent.height);
+    LoadSwapChain(physicalDevice, surface, graphicsIndex, presentIndex, concurrentSharing, config.imageCount, oldSwapChain);
     LoadImages();
     LoadImageViews();
-    INFO("Created swapchain");
+    LOG_INFO(SWAPCHAIN, FORMAT("Created swapchain, %ux%u, %s, %u images",
+        imageExtent.width, imageExtent.height, GetPresentModeName(presentMode), images.size()));
 }
 
 SwapChain::SwapChain(SwapChain&& other):
     swapChain { other.swapChain },
     logicalDevice { other.logicalDevice },
+    allocator { other.allocator },
     imageFormat { other.imageFormat },
     presentMode { other.presentMode },
     imageExtent { other.imageExtent },
     images { std::move(images) } {
 
     other.swapChain = VK_NULL_HANDLE;
-    INFO("Moved swapchain");
+    LOG_INFO(SWAPCHAIN, "Moved swapchain");
 }
 
 SwapChain::~SwapChain() {
 
     for(auto framebuffer: framebuffers) {
-        vkDestroyFramebuffer(logicalDevice, framebuffer, nullptr);
+        vkDestroyFramebuffer(logicalDevice, framebuffer, allocator);
     }
 
     for(auto imageView: imageViews) {
-        vkDestroyImageView(logicalDevice, imageView, nullptr);
+        vkDestroyImageView(logicalDevice, imageView, allocator);
     }
 
     if (swapChain != VK_NULL_HANDLE) {
-        vkDestroySwapchainKHR(logicalDevice, swapChain, nullptr);
-        INFO("Destroyed swapchain");
+        vkDestroySwapchainKHR(logicalDevice, swapChain, allocator);
+        LOG_INFO(SWAPCHAIN, "Destroyed swapchain");
     }
 }
 
 void SwapChain::LoadSurfaceFormat(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface) {
-    uint32_t formatCount;
-    std::vector<VkSurfaceFormatKHR> availableFmts;
-
-    vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, nullptr);
-    if (formatCount != 0) {
-        availableFmts.resize(formatCount);
-        vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, availableFmts.data());
-    }
-
-    if (availableFmts.size() == 1 && availableFmts[0].format == VK_FORMAT_UNDEFINED) {
-        imageFormat = { VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
-    }
-    else {
-        for (const auto& fmt : availableFmts) {
-            if (fmt.format == VK_FORMAT_B8G8R8A8_UNORM &&
-                fmt.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
-                imageFormat = fmt;
-            }
-        }
-    }
+    imageFormat = ChooseSurfaceFormat(physicalDevice, surface);
 }
 
-void SwapChain::LoadPresentMode(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface) {
+void SwapChain::LoadPresentMode(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, const std::vector<VkPresentModeKHR>& preferredModes) {
     uint32_t presentModeCount;
     std::vector<VkPresentModeKHR> availablePresentModes;
     vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, nullptr);
@@ -75,15 +101,14 @@ void SwapChain::LoadPresentMode(VkPhysicalDevice physicalDevice, VkSurfaceKHR su
         vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, availablePresentModes.data());
     }
 
-    auto bestMode = VK_PRESENT_MODE_FIFO_KHR;
-    for (const auto& mode: availablePresentModes) {
-        switch(mode) {
-        case VK_PRESENT_MODE_MAILBOX_KHR:   presentMode = mode; return;
-        case VK_PRESENT_MODE_IMMEDIATE_KHR: bestMode = mode;    break;
-        default:                            break;
+    for (const auto& mode: preferredModes) {
+        if (std::find(availablePresentModes.begin(), availablePresentModes.end(), mode) != availablePresentModes.end()) {
+            presentMode = mode;
+            return;
         }
     }
-    presentMode = bestMode;
+    // the only mode every surface has to support
+    presentMode = VK_PRESENT_MODE_FIFO_KHR;
 }
 
 void SwapChain::LoadSwapExent(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, uint32_t width, uint32_t height) {
@@ -107,11 +132,13 @@ void SwapChain::LoadSwapExent(VkPhysicalDevice physicalDevice, VkSurfaceKHR surf
     }
 }
 
-void SwapChain::LoadSwapChain(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, int graphicsIndex, int presentIndex) {
+void SwapChain::LoadSwapChain(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, int graphicsIndex, int presentIndex, bool concurrentSharing, uint32_t requestedImageCount, VkSwapchainKHR oldSwapChain) {
     VkSurfaceCapabilitiesKHR capabilities;
     vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, surface, &capabilities);
 
-    uint32_t imageCount = capabilities.minImageCount + 1;
+    uint32_t imageCount = requestedImageCount != 0 ?
+        std::max(requestedImageCount, capabilities.minImageCount) :
+        capabilities.minImageCount + 1;
     if (capabilities.maxImageCount > 0 && imageCount > capabilities.maxImageCount) {
         imageCount = capabilities.maxImageCount;
     }
@@ -130,7 +157,7 @@ void SwapChain::LoadSwapChain(VkPhysicalDevice physicalDevice, VkSurfaceKHR surf
         static_cast<uint32_t>(graphicsIndex),
         static_cast<uint32_t>(presentIndex) };
 
-    if (graphicsIndex != presentIndex) {
+    if (concurrentSharing) {
         createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
         createInfo.queueFamilyIndexCount = 2;
         createInfo.pQueueFamilyIndices = familyIndices;
@@ -145,9 +172,10 @@ void SwapChain::LoadSwapChain(VkPhysicalDevice physicalDevice, VkSurfaceKHR surf
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = presentMode;
     createInfo.clipped = VK_TRUE;
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    // lets the driver hand over resources, the old swapchain is retired but still has to be destroyed
+    createInfo.oldSwapchain = oldSwapChain;
 
-    if (vkCreateSwapchainKHR(logicalDevice, &createInfo, nullptr, &swapChain) != VK_SUCCESS) {
+    if (vkCreateSwapchainKHR(logicalDevice, &createInfo, allocator, &swapChain) != VK_SUCCESS) {
         throw std::runtime_error("Could not create swapchain");
     }
 }
@@ -178,7 +206,7 @@ void SwapChain::LoadImageViews() {
         createInfo.subresourceRange.levelCount = 1;
         createInfo.subresourceRange.baseArrayLayer = 0;
         createInfo.subresourceRange.layerCount = 1;
-        if (vkCreateImageView(logicalDevice, &createInfo, nullptr, &imageView) != VK_SUCCESS) {
+        if (vkCreateImageView(logicalDevice, &createInfo, allocator, &imageView) != VK_SUCCESS) {
             throw std::runtime_error("Could not create image view");
         }
         imageViews.push_back(imageView);
@@ -198,7 +226,7 @@ void SwapChain::LoadFramebuffers(VkRenderPass renderPass) {
         createInfo.height = imageExtent.height;
         createInfo.layers = 1;
 
-        if (vkCreateFramebuffer(logicalDevice, &createInfo, nullptr, &framebuffers[i]) != VK_SUCCESS) {
+        if (vkCreateFramebuffer(logicalDevice, &createInfo, allocator, &framebuffers[i]) != VK_SUCCESS) {
             throw std::runtime_error("Could not create framebuffer");
         }
     }
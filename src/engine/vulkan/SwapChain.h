@@ -6,18 +6,56 @@
 #include <vulkan/vulkan.h>
 
 #include "logging/StdLogger.h"
+#include "utility/Format.h"
 
 namespace engine::vulkan {
 
+// Per frame resources are allocated for this many frames, configs may use fewer
+const size_t maxFramesInFlight = 3;
+
+// Differing graphics and present families hand exclusive images over with
+// ownership barriers, CONCURRENT sharing is the fallback
+const bool preferQueueOwnershipTransfer = true;
+
+struct SwapChainConfig {
+    // Tried in order, FIFO is used when none of them is available
+    std::vector<VkPresentModeKHR>   presentModes;
+    // 0 asks for one more than the surface minimum, other counts are clamped to the surface limits
+    uint32_t                        imageCount;
+    // Frames recorded ahead of the gpu, 1 to maxFramesInFlight
+    size_t                          framesInFlight;
+};
+
+enum class SwapChainPreset {
+    // mailbox or immediate with one more image than needed, two frames in flight
+    DEFAULT,
+    // never waits for vblank and records only one frame ahead, may tear
+    LOW_LATENCY,
+    // vsynced with as few images and frames in flight as possible
+    LOW_POWER,
+    // tear free with enough images and frames in flight to keep the gpu busy
+    THROUGHPUT
+};
+
+SwapChainConfig GetSwapChainPreset(SwapChainPreset preset);
+const char* GetPresentModeName(VkPresentModeKHR mode);
+// The format a swapchain on this surface is created with, known before creating it
+VkSurfaceFormatKHR ChooseSurfaceFormat(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface);
+
 class SwapChain {
 
 public:
 
                                 SwapChain(VkPhysicalDevice physicalDevice,
                                     const VkDevice logicalDevice_,
+                                    const VkAllocationCallbacks* allocator_,
                                     VkSurfaceKHR surface,
                                     int graphicsIndex,
-                                    int presentIndex);
+                                    int presentIndex,
+                                    bool concurrentSharing,
+                                    const SwapChainConfig& config,
+                                    VkExtent2D windowExtent,
+                                    VkSwapchainKHR oldSwapChain);
                                 SwapChain(SwapChain&& other);
                                 ~SwapChain();
 
@@ -25,6 +63,9 @@ public:
 
     VkSurfaceFormatKHR          GetImageFormat() const { return imageFormat; }
     VkExtent2D                  GetImageExtent() const { return imageExtent; }
+    VkPresentModeKHR            GetPresentMode() const { return presentMode; }
+    size_t                      GetImageCount() const { return images.size(); }
+    VkImage                     GetImage(size_t index) const { return images[index]; }
     size_t                      GetFramebufferCount() const { return framebuffers.size(); }
     VkFramebuffer               GetFramebuffer(size_t index) const { return framebuffers[index]; }
     VkSwapchainKHR              GetSwapChain() const { return swapChain; };
@@ -33,6 +74,7 @@ public:
 private:
     VkSwapchainKHR              swapChain;
     const VkDevice              logicalDevice;
+    const VkAllocationCallbacks* allocator;
     VkSurfaceFormatKHR          imageFormat;
     VkPresentModeKHR            presentMode;
     VkExtent2D                  imageExtent;
@@ -43,7 +85,9 @@ private:
 
 
     void                LoadSurfaceFormat(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface);
-    void                LoadPresentMode(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface);
+    void                LoadPresentMode(VkPhysicalDevice physicalDevice,
+                                        VkSurfaceKHR surface,
+                                        const std::vector<VkPresentModeKHR>& preferredModes);
     void                LoadSwapExent(VkPhysicalDevice physicalDevice,
                                         VkSurfaceKHR surface,
                                         uint32_t width,
@@ -51,7 +95,10 @@ private:
     void                LoadSwapChain(VkPhysicalDevice physicalDevice,
                                         VkSurfaceKHR surface,
                                         int graphicsIndex,
-                                        int presentIndex);
+                                        int presentIndex,
+                                        bool concurrentSharing,
+                                        uint32_t requestedImageCount,
+                                        VkSwapchainKHR oldSwapChain);
     void                LoadImages();
     void                LoadImageViews();
 
@@ -0,0 +1,554 @@
+#include "TextureStreamer.h"
+
+namespace engine::vulkan {
+
+// frames a texture keeps its requested detail after the last usage report
+static const uint64_t usageTimeout = 60;
+
+static const VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static VkImageMemoryBarrier CreateLevelBarrier(VkImage image,
+    uint32_t baseLevel,
+    uint32_t levelCount,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    VkAccessFlags srcAccess,
+    VkAccessFlags dstAccess) {
+
+    VkImageMemoryBarrier barrier {};
+
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = baseLevel;
+    barrier.subresourceRange.levelCount = levelCount;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    return barrier;
+}
+
+static bool GetVulkanFormat(uint32_t format, VkFormat& vkFormat) {
+    switch (static_cast<TextureFileFormat>(format)) {
+        case TextureFileFormat::RGBA8_UNORM:
+            vkFormat = VK_FORMAT_R8G8B8A8_UNORM;
+            return true;
+        case TextureFileFormat::RGBA8_SRGB:
+            vkFormat = VK_FORMAT_R8G8B8A8_SRGB;
+            return true;
+        default:
+            return false;
+    }
+}
+
+TextureStreamer::TextureStreamer(const Device& device_,
+    const VkAllocationCallbacks* allocator_,
+    BindlessTable& bindless_,
+    io::AsyncIO& asyncIO_,
+    size_t frameCount_,
+    const TextureStreamingConfig& config_):
+    device { device_ },
+    logicalDevice { device_.GetLogicalDevice() },
+    allocator { allocator_ },
+    bindless { bindless_ },
+    asyncIO { asyncIO_ },
+    frameCount { frameCount_ },
+    config { config_ },
+    uploader { device_, allocator_, config_.stagingSize },
+    sampler { VK_NULL_HANDLE },
+    frameNumber { 0 },
+    residentBytes { 0 },
+    streamsInFlight { 0 },
+    streamedLevels { 0 },
+    evictedLevels { 0 } {
+
+    LoadSampler();
+    LOG_INFO(TEXTURES, FORMAT("Created texture streamer, %llu MiB budget",
+        static_cast<unsigned long long>(config.budget / (1024 * 1024))));
+}
+
+TextureStreamer::~TextureStreamer() {
+    // the device is idle by now
+    for (auto& texture: textures) {
+        if (texture.resident.image != VK_NULL_HANDLE) {
+            Destroy(texture.resident);
+        }
+    }
+    for (auto& entry: retired) {
+        Destroy(entry.residency);
+    }
+    if (sampler != VK_NULL_HANDLE) {
+        vkDestroySampler(logicalDevice, sampler, allocator);
+    }
+    LOG_DEBUG(TEXTURES, FORMAT("Destroyed texture streamer, streamed %llu levels, evicted %llu",
+        static_cast<unsigned long long>(streamedLevels),
+        static_cast<unsigned long long>(evictedLevels)));
+}
+
+void TextureStreamer::LoadSampler() {
+    VkSamplerCreateInfo createInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    createInfo.magFilter = VK_FILTER_LINEAR;
+    createInfo.minFilter = VK_FILTER_LINEAR;
+    createInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    createInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    createInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    createInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    createInfo.minLod = 0.0f;
+    // views only cover resident levels, so level 0 of the view is the best one available
+    createInfo.maxLod = VK_LOD_CLAMP_NONE;
+    createInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+
+    if (vkCreateSampler(logicalDevice, &createInfo, allocator, &sampler) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create texture sampler");
+    }
+}
+
+TextureHandle TextureStreamer::Load(const std::string& filename) {
+    TextureHandle handle = static_cast<TextureHandle>(textures.size());
+    Texture texture {};
+
+    texture.filename = filename;
+    texture.state = TextureState::LOADING_HEADER;
+    texture.format = VK_FORMAT_UNDEFINED;
+    texture.resident = Residency { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, 0, invalidBindlessIndex, 0 };
+    textures.push_back(texture);
+
+    asyncIO.Read(filename, [this, handle](io::ReadResult& result) { OnHeader(handle, result); }, 0, textureFileHeaderReadSize);
+    return handle;
+}
+
+void TextureStreamer::Fail(Texture& texture, const std::string& reason) {
+    BLOG_WARN(TEXTURES, "Could not load texture %s: %s", texture.filename, reason);
+    texture.state = TextureState::FAILED;
+}
+
+void TextureStreamer::OnHeader(TextureHandle handle, io::ReadResult& result) {
+    Texture& texture = textures[handle];
+    TextureFileHeader header;
+
+    if (!result.success) {
+        return Fail(texture, result.error);
+    }
+    if (result.data.size() < sizeof(header)) {
+        return Fail(texture, "file too small");
+    }
+    std::memcpy(&header, result.data.data(), sizeof(header));
+    if (std::memcmp(header.magic, textureFileMagic, sizeof(header.magic)) != 0 || header.version != textureFileVersion) {
+        return Fail(texture, "not a texture file");
+    }
+    if (header.mipCount == 0 || header.mipCount > maxTextureFileMips ||
+        result.data.size() < sizeof(header) + header.mipCount * sizeof(TextureFileMip)) {
+        return Fail(texture, "bad mip table");
+    }
+    if (!GetVulkanFormat(header.format, texture.format)) {
+        return Fail(texture, "unsupported format");
+    }
+
+    uint32_t texelSize = GetTextureFileTexelSize(static_cast<TextureFileFormat>(header.format));
+    texture.mips.resize(header.mipCount);
+    std::memcpy(texture.mips.data(), result.data.data() + sizeof(header), header.mipCount * sizeof(TextureFileMip));
+
+    const TextureFileMip& top = texture.mips[0];
+    if (top.width == 0 || top.height == 0) {
+        return Fail(texture, "bad mip layout");
+    }
+    // the image is created with this many levels, more than down to 1x1 is invalid
+    uint32_t fullChainCount = 1;
+    while ((std::max(top.width, top.height) >> fullChainCount) > 0) {
+        fullChainCount++;
+    }
+    if (header.mipCount > fullChainCount) {
+        return Fail(texture, "more mip levels than the size allows");
+    }
+
+    texture.tailLevel = header.mipCount - 1;
+    for (uint32_t level = 0; level < header.mipCount; level++) {
+        const TextureFileMip& mip = texture.mips[level];
+
+        if (mip.width != std::max(1u, top.width >> level) || mip.height != std::max(1u, top.height >> level)) {
+            return Fail(texture, "mip sizes do not halve per level");
+        }
+        // smaller levels come first in the file
+        if (mip.size != uint64_t(mip.width) * mip.height * texelSize ||
+            (level > 0 && mip.offset >= texture.mips[level - 1].offset)) {
+            return Fail(texture, "bad mip layout");
+        }
+        if (std::max(mip.width, mip.height) <= config.tailSize) {
+            texture.tailLevel = std::min(texture.tailLevel, level);
+        }
+    }
+    if (texture.lastUsedFrame == 0) {
+        texture.requestedLevel = texture.tailLevel;
+    }
+
+    uint64_t tailStart = texture.mips.back().offset;
+    uint64_t tailEnd = texture.mips[texture.tailLevel].offset + texture.mips[texture.tailLevel].size;
+
+    texture.state = TextureState::LOADING_TAIL;
+    asyncIO.Read(texture.filename, [this, handle](io::ReadResult& tail) { OnTail(handle, tail); }, tailStart, tailEnd - tailStart);
+}
+
+void TextureStreamer::OnTail(TextureHandle handle, io::ReadResult& result) {
+    Texture& texture = textures[handle];
+    uint64_t tailStart = texture.mips.back().offset;
+    std::vector<const uint8_t*> levelData(texture.mips.size(), nullptr);
+
+    if (!result.success) {
+        return Fail(texture, result.error);
+    }
+    const TextureFileMip& tailTop = texture.mips[texture.tailLevel];
+    if (result.data.size() != tailTop.offset + tailTop.size - tailStart) {
+        return Fail(texture, "file truncated");
+    }
+    for (uint32_t level = texture.tailLevel; level < texture.mips.size(); level++) {
+        levelData[level] = result.data.data() + (texture.mips[level].offset - tailStart);
+    }
+
+    // the tail is small and needed to show anything at all, so it loads even if that means going over budget
+    MakeRoom(EstimateSize(texture, texture.tailLevel), handle);
+    if (!Rebuild(texture, texture.tailLevel, levelData)) {
+        return Fail(texture, "mip tail does not fit into staging memory");
+    }
+    texture.state = TextureState::RESIDENT;
+    BLOG_DEBUG(TEXTURES, "Texture %s resident from level %u of %u",
+        texture.filename, texture.tailLevel, static_cast<uint32_t>(texture.mips.size()));
+}
+
+void TextureStreamer::OnLevel(TextureHandle handle, uint32_t level, io::ReadResult& result) {
+    Texture& texture = textures[handle];
+    std::vector<const uint8_t*> levelData(texture.mips.size(), nullptr);
+
+    streamsInFlight--;
+    texture.streaming = false;
+    if (!result.success || result.data.size() != texture.mips[level].size) {
+        BLOG_WARN(TEXTURES, "Could not stream level %u of %s", level, texture.filename);
+        texture.streamFailed = true;
+        return;
+    }
+    // the texture may have been evicted below this level while the read was in flight
+    if (level + 1 != texture.resident.baseLevel) {
+        return;
+    }
+    if (!MakeRoom(EstimateSize(texture, level) - EstimateSize(texture, texture.resident.baseLevel), handle)) {
+        return;
+    }
+    levelData[level] = result.data.data();
+    if (!Rebuild(texture, level, levelData)) {
+        BLOG_WARN(TEXTURES, "Level %u of %s does not fit into staging memory", level, texture.filename);
+        texture.streamFailed = true;
+        return;
+    }
+    streamedLevels++;
+}
+
+void TextureStreamer::ReportUsage(TextureHandle handle, float screenSize) {
+    Texture& texture = textures[handle];
+    uint32_t level = 0;
+
+    if (!texture.mips.empty()) {
+        float extent = static_cast<float>(std::max(texture.mips[0].width, texture.mips[0].height));
+        uint32_t lastLevel = static_cast<uint32_t>(texture.mips.size()) - 1;
+
+        // one texel per pixel is enough
+        level = screenSize <= 0.0f ? lastLevel :
+            static_cast<uint32_t>(std::min<float>(lastLevel, std::max(0.0f, std::floor(std::log2(extent / screenSize)))));
+    }
+    if (texture.lastUsedFrame != frameNumber) {
+        texture.requestedLevel = level;
+    } else {
+        texture.requestedLevel = std::min(texture.requestedLevel, level);
+    }
+    texture.lastUsedFrame = frameNumber;
+}
+
+uint32_t TextureStreamer::GetWantedLevel(const Texture& texture) const {
+    if (frameNumber - texture.lastUsedFrame > usageTimeout) {
+        return texture.tailLevel;
+    }
+    return std::min(texture.requestedLevel, texture.tailLevel);
+}
+
+VkDeviceSize TextureStreamer::EstimateSize(const Texture& texture, uint32_t baseLevel) const {
+    VkDeviceSize size = 0;
+
+    for (uint32_t level = baseLevel; level < texture.mips.size(); level++) {
+        size += texture.mips[level].size;
+    }
+    return size;
+}
+
+bool TextureStreamer::MakeRoom(VkDeviceSize size, TextureHandle keep) {
+    while (residentBytes + size > config.budget) {
+        Texture* victim = nullptr;
+
+        // textures holding more than they need, or used less recently than the one
+        // making room, least recently used first. Anything else would just thrash.
+        for (TextureHandle handle = 0; handle < textures.size(); handle++) {
+            Texture& texture = textures[handle];
+
+            if (handle == keep || texture.state != TextureState::RESIDENT ||
+                texture.resident.baseLevel >= texture.tailLevel || texture.streaming) {
+                continue;
+            }
+            bool surplus = GetWantedLevel(texture) > texture.resident.baseLevel;
+            if (!surplus && texture.lastUsedFrame >= textures[keep].lastUsedFrame) {
+                continue;
+            }
+            if (victim == nullptr || texture.lastUsedFrame < victim->lastUsedFrame) {
+                victim = &texture;
+            }
+        }
+        if (victim == nullptr) {
+            return false;
+        }
+        if (!Rebuild(*victim, victim->resident.baseLevel + 1, std::vector<const uint8_t*>(victim->mips.size(), nullptr))) {
+            return false;
+        }
+        evictedLevels++;
+    }
+    return true;
+}
+
+void TextureStreamer::StreamLevels() {
+    std::vector<TextureHandle> candidates;
+
+    for (TextureHandle handle = 0; handle < textures.size(); handle++) {
+        const Texture& texture = textures[handle];
+
+        if (texture.state == TextureState::RESIDENT && !texture.streaming && !texture.streamFailed &&
+            GetWantedLevel(texture) < texture.resident.baseLevel) {
+            candidates.push_back(handle);
+        }
+    }
+    // recently used and far from their wanted detail first
+    std::sort(candidates.begin(), candidates.end(), [this](TextureHandle a, TextureHandle b) {
+        const Texture& first = textures[a];
+        const Texture& second = textures[b];
+
+        if (first.lastUsedFrame != second.lastUsedFrame) {
+            return first.lastUsedFrame > second.lastUsedFrame;
+        }
+        return first.resident.baseLevel - GetWantedLevel(first) > second.resident.baseLevel - GetWantedLevel(second);
+    });
+
+    for (auto handle: candidates) {
+        if (streamsInFlight >= config.maxStreamsInFlight) {
+            break;
+        }
+        Texture& texture = textures[handle];
+        uint32_t level = texture.resident.baseLevel - 1;
+
+        if (!MakeRoom(EstimateSize(texture, level) - EstimateSize(texture, texture.resident.baseLevel), handle)) {
+            continue;
+        }
+        texture.streaming = true;
+        streamsInFlight++;
+        asyncIO.Read(texture.filename,
+            [this, handle, level](io::ReadResult& result) { OnLevel(handle, level, result); },
+            texture.mips[level].offset,
+            texture.mips[level].size);
+    }
+}
+
+void TextureStreamer::Update() {
+    TRACE_SCOPE("TextureStreamer::Update");
+    // images replaced before the frames in flight were recorded are no longer referenced
+    while (!retired.empty() &&
+        retired.front().frame + frameCount <= frameNumber &&
+        uploader.IsComplete(retired.front().uploadSerial)) {
+        Destroy(retired.front().residency);
+        retired.pop_front();
+    }
+    StreamLevels();
+    uploader.Submit();
+    frameNumber++;
+}
+
+bool TextureStreamer::Rebuild(Texture& texture, uint32_t baseLevel, const std::vector<const uint8_t*>& levelData) {
+    const Residency old = texture.resident;
+    uint32_t mipCount = static_cast<uint32_t>(texture.mips.size());
+    uint32_t levelCount = mipCount - baseLevel;
+    VkDeviceSize uploadSize = 0;
+
+    for (uint32_t level = baseLevel; level < mipCount; level++) {
+        if (levelData[level] != nullptr) {
+            uploadSize += AlignUp(texture.mips[level].size, 16);
+        } else if (old.image == VK_NULL_HANDLE || level < old.baseLevel) {
+            throw std::runtime_error("Texture level " + std::to_string(level) + " of " + texture.filename + " is not resident");
+        }
+    }
+    if (uploadSize > uploader.GetAvailable()) {
+        uploader.Submit();
+    }
+    // staged before anything is recorded, so running out of space leaves nothing referring to a half built image
+    std::vector<VkDeviceSize> stagedOffsets(mipCount, 0);
+    for (uint32_t level = baseLevel; level < mipCount; level++) {
+        if (levelData[level] != nullptr && !uploader.Stage(levelData[level], texture.mips[level].size, stagedOffsets[level])) {
+            return false;
+        }
+    }
+
+    Residency next { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, 0, invalidBindlessIndex, baseLevel };
+    VkImageCreateInfo imageInfo {};
+    VkMemoryRequirements requirements;
+    VkMemoryAllocateInfo allocInfo {};
+
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = texture.format;
+    imageInfo.extent = { texture.mips[baseLevel].width, texture.mips[baseLevel].height, 1 };
+    imageInfo.mipLevels = levelCount;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(logicalDevice, &imageInfo, allocator, &next.image) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create texture image");
+    }
+    vkGetImageMemoryRequirements(logicalDevice, next.image, &requirements);
+
+    int memoryType = device.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (memoryType == -1) {
+        memoryType = device.FindMemoryType(requirements.memoryTypeBits, 0);
+    }
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = static_cast<uint32_t>(memoryType);
+
+    if (memoryType == -1 || vkAllocateMemory(logicalDevice, &allocInfo, allocator, &next.memory) != VK_SUCCESS) {
+        BLOG_WARN(TEXTURES, "Could not allocate %llu bytes for texture %s",
+            static_cast<unsigned long long>(requirements.size), texture.filename);
+        vkDestroyImage(logicalDevice, next.image, allocator);
+        return false;
+    }
+    vkBindImageMemory(logicalDevice, next.image, next.memory, 0);
+    next.memorySize = requirements.size;
+
+    VkCommandBuffer commandBuffer = uploader.GetCommandBuffer();
+    VkImageMemoryBarrier barrier { CreateLevelBarrier(next.image, 0, levelCount,
+        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT) };
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    if (old.image != VK_NULL_HANDLE) {
+        // frames submitted earlier may still sample the old image, the barrier waits for them
+        uint32_t copyFrom = std::max(baseLevel, old.baseLevel);
+        VkImageMemoryBarrier oldBarrier { CreateLevelBarrier(old.image, copyFrom - old.baseLevel, mipCount - copyFrom,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_READ_BIT) };
+
+        vkCmdPipelineBarrier(commandBuffer, shaderStages, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &oldBarrier);
+    }
+
+    for (uint32_t level = baseLevel; level < mipCount; level++) {
+        const TextureFileMip& mip = texture.mips[level];
+        VkExtent3D extent { mip.width, mip.height, 1 };
+
+        if (levelData[level] != nullptr) {
+            VkBufferImageCopy region {};
+
+            region.bufferOffset = stagedOffsets[level];
+            region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - baseLevel, 0, 1 };
+            region.imageExtent = extent;
+            vkCmdCopyBufferToImage(commandBuffer, uploader.GetBuffer(), next.image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        } else {
+            VkImageCopy region {};
+
+            region.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - old.baseLevel, 0, 1 };
+            region.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - baseLevel, 0, 1 };
+            region.extent = extent;
+            vkCmdCopyImage(commandBuffer, old.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                next.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        }
+    }
+
+    barrier = CreateLevelBarrier(next.image, 0, levelCount,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, shaderStages,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkImageViewCreateInfo viewInfo {};
+
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = next.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = texture.format;
+    viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1 };
+
+    if (vkCreateImageView(logicalDevice, &viewInfo, allocator, &next.view) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create texture image view");
+    }
+    // a fresh index instead of rewriting the old one, frames in flight still read that descriptor
+    next.bindlessIndex = bindless.AddTexture(next.view, sampler);
+
+    if (old.image != VK_NULL_HANDLE) {
+        residentBytes -= old.memorySize;
+        Retire(old);
+    }
+    residentBytes += next.memorySize;
+    texture.resident = next;
+    return true;
+}
+
+void TextureStreamer::Retire(const Residency& residency) {
+    bindless.RemoveTexture(residency.bindlessIndex);
+    retired.push_back(RetiredResidency { residency, frameNumber, uploader.GetCurrentSerial() });
+}
+
+void TextureStreamer::Destroy(const Residency& residency) {
+    if (residency.view != VK_NULL_HANDLE) {
+        vkDestroyImageView(logicalDevice, residency.view, allocator);
+    }
+    if (residency.image != VK_NULL_HANDLE) {
+        vkDestroyImage(logicalDevice, residency.image, allocator);
+    }
+    if (residency.memory != VK_NULL_HANDLE) {
+        vkFreeMemory(logicalDevice, residency.memory, allocator);
+    }
+}
+
+uint32_t TextureStreamer::GetBindlessIndex(TextureHandle handle) const {
+    const Texture& texture = textures[handle];
+    return texture.state == TextureState::RESIDENT ? texture.resident.bindlessIndex : invalidBindlessIndex;
+}
+
+uint32_t TextureStreamer::GetResidentLevel(TextureHandle handle) const {
+    const Texture& texture = textures[handle];
+    return texture.state == TextureState::RESIDENT ? texture.resident.baseLevel : static_cast<uint32_t>(texture.mips.size());
+}
+
+TextureStreamingStats TextureStreamer::GetStats() const {
+    TextureStreamingStats stats {};
+
+    stats.textureCount = textures.size();
+    for (auto& texture: textures) {
+        if (texture.state == TextureState::RESIDENT) {
+            stats.residentCount++;
+        }
+    }
+    stats.residentBytes = residentBytes;
+    stats.budget = config.budget;
+    stats.streamedLevels = streamedLevels;
+    stats.evictedLevels = evictedLevels;
+    return stats;
+}
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+#include "utility/TextureFileFormat.h"
+#include "io/AsyncIO.h"
+#include "Device.h"
+#include "BindlessTable.h"
+#include "StagingUploader.h"
+
+namespace engine::vulkan {
+
+struct TextureStreamingConfig {
+    VkDeviceSize    budget;
+    uint32_t        tailSize;
+    uint32_t        maxStreamsInFlight;
+    VkDeviceSize    stagingSize;
+};
+
+// The tail is every level up to tailSize texels on its longer side
+const TextureStreamingConfig defaultTextureStreamingConfig { 256 * 1024 * 1024, 64, 4, 32 * 1024 * 1024 };
+// Streamed and drawn on the triangle if set, a file in the TextureFileFormat layout, e.g. TV_TEXTURE=brick.tex
+const char* const textureEnvVar = "TV_TEXTURE";
+
+using TextureHandle = uint32_t;
+
+const TextureHandle invalidTextureHandle = 0xFFFFFFFF;
+
+struct TextureStreamingStats {
+    size_t          textureCount;
+    size_t          residentCount;
+    VkDeviceSize    residentBytes;
+    VkDeviceSize    budget;
+    uint64_t        streamedLevels;
+    uint64_t        evictedLevels;
+};
+
+// Streams textures in the TextureFileFormat layout. Loading reads the header
+// and then the mip tail in one go, so a texture is usable after two small reads.
+// Higher levels are read one at a time while ReportUsage asks for more detail
+// than is resident. An image only holds its resident levels, so adding or
+// dropping a level rebuilds it, copying the kept levels on the gpu. When over
+// budget the least recently used textures give up levels first.
+class TextureStreamer {
+
+public:
+                            TextureStreamer(const Device& device_,
+                                const VkAllocationCallbacks* allocator_,
+                                BindlessTable& bindless_,
+                                io::AsyncIO& asyncIO_,
+                                size_t frameCount_,
+                                const TextureStreamingConfig& config_);
+                            ~TextureStreamer();
+
+    TextureHandle           Load(const std::string& filename);
+
+    // screenSize is the texture's largest extent on screen in pixels this frame
+    void                    ReportUsage(TextureHandle handle, float screenSize);
+
+    // Once per frame after its fence was waited for and before it is recorded
+    void                    Update();
+
+    // invalidBindlessIndex until the mip tail is resident, may change whenever levels are added or dropped
+    uint32_t                GetBindlessIndex(TextureHandle handle) const;
+    uint32_t                GetResidentLevel(TextureHandle handle) const;
+    TextureStreamingStats   GetStats() const;
+
+private:
+    enum class TextureState {
+        LOADING_HEADER,
+        LOADING_TAIL,
+        RESIDENT,
+        FAILED
+    };
+
+    struct Residency {
+        VkImage             image;
+        VkDeviceMemory      memory;
+        VkImageView         view;
+        VkDeviceSize        memorySize;
+        uint32_t            bindlessIndex;
+        uint32_t            baseLevel;
+    };
+
+    struct Texture {
+        std::string                 filename;
+        TextureState                state;
+        VkFormat                    format;
+        std::vector<TextureFileMip> mips;
+        uint32_t                    tailLevel;
+        Residency                   resident;
+        uint32_t                    requestedLevel;
+        uint64_t                    lastUsedFrame;
+        bool                        streaming;
+        bool                        streamFailed;
+    };
+
+    struct RetiredResidency {
+        Residency           residency;
+        uint64_t            frame;
+        uint64_t            uploadSerial;
+    };
+
+    const Device&                   device;
+    VkDevice                        logicalDevice;
+    const VkAllocationCallbacks*    allocator;
+    BindlessTable&                  bindless;
+    io::AsyncIO&                    asyncIO;
+    size_t                          frameCount;
+    TextureStreamingConfig          config;
+    StagingUploader                 uploader;
+    VkSampler                       sampler;
+    std::vector<Texture>            textures;
+    std::deque<RetiredResidency>    retired;
+    uint64_t                        frameNumber;
+    VkDeviceSize                    residentBytes;
+    uint32_t                        streamsInFlight;
+    uint64_t                        streamedLevels;
+    uint64_t                        evictedLevels;
+
+    void                    LoadSampler();
+    void                    OnHeader(TextureHandle handle, io::ReadResult& result);
+    void                    OnTail(TextureHandle handle, io::ReadResult& result);
+    void                    OnLevel(TextureHandle handle, uint32_t level, io::ReadResult& result);
+    void                    Fail(Texture& texture, const std::string& reason);
+
+    uint32_t                GetWantedLevel(const Texture& texture) const;
+    VkDeviceSize            EstimateSize(const Texture& texture, uint32_t baseLevel) const;
+    bool                    MakeRoom(VkDeviceSize size, TextureHandle keep);
+    void                    StreamLevels();
+
+    // Replaces the texture's image with one holding baseLevel and below. levelData
+    // supplies new levels indexed by level, null entries are copied from the old image.
+    bool                    Rebuild(Texture& texture, uint32_t baseLevel, const std::vector<const uint8_t*>& levelData);
+    void                    Retire(const Residency& residency);
+    void                    Destroy(const Residency& residency);
+};
+
+}
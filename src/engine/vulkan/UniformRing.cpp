@@ -0,0 +1,129 @@
+#include "UniformRing.h"
+
+namespace engine::vulkan {
+
+static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+UniformRing::UniformRing(const Device& device_, const VkAllocationCallbacks* allocator_, size_t frameCount_, VkDeviceSize frameSize_, VkBufferUsageFlags usage):
+    device { device_.GetLogicalDevice() },
+    allocator { allocator_ },
+    buffer { VK_NULL_HANDLE },
+    memory { VK_NULL_HANDLE },
+    mapped { nullptr },
+    coherent { true },
+    frameCount { frameCount_ },
+    alignment { 1 },
+    atomSize { 1 },
+    frameSize { 0 },
+    frameStart { 0 },
+    head { 0 } {
+
+    VkPhysicalDeviceLimits limits { device_.GetProperties().limits };
+
+    if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
+        alignment = std::max(alignment, limits.minUniformBufferOffsetAlignment);
+    }
+    if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) {
+        alignment = std::max(alignment, limits.minStorageBufferOffsetAlignment);
+    }
+    atomSize = std::max<VkDeviceSize>(1, limits.nonCoherentAtomSize);
+    frameSize = AlignUp(frameSize_, std::max(alignment, atomSize));
+
+    LoadBuffer(usage);
+    LoadMemory(device_);
+    LOG_INFO(MEMORY, FORMAT("Created uniform ring, %llu bytes per frame, %llu byte alignment",
+        static_cast<unsigned long long>(frameSize),
+        static_cast<unsigned long long>(alignment)));
+}
+
+UniformRing::~UniformRing() {
+    if (mapped != nullptr) {
+        vkUnmapMemory(device, memory);
+    }
+    if (buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, buffer, allocator);
+    }
+    if (memory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, memory, allocator);
+    }
+    LOG_DEBUG(MEMORY, "Destroyed uniform ring");
+}
+
+void UniformRing::LoadBuffer(VkBufferUsageFlags usage) {
+    VkBufferCreateInfo createInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = frameSize * frameCount;
+    createInfo.usage = usage;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &createInfo, allocator, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Could not create uniform ring buffer");
+    }
+}
+
+void UniformRing::LoadMemory(const Device& device_) {
+    VkMemoryRequirements requirements;
+    VkMemoryAllocateInfo allocInfo {};
+
+    vkGetBufferMemoryRequirements(device, buffer, &requirements);
+
+    int memoryType = device_.FindMemoryType(requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (memoryType == -1) {
+        memoryType = device_.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+        coherent = false;
+    }
+    if (memoryType == -1) {
+        throw std::runtime_error("Could not find host visible memory for uniform ring");
+    }
+
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = static_cast<uint32_t>(memoryType);
+
+    if (vkAllocateMemory(device, &allocInfo, allocator, &memory) != VK_SUCCESS) {
+        throw std::runtime_error("Could not allocate uniform ring memory");
+    }
+    vkBindBufferMemory(device, buffer, memory, 0);
+
+    void* data = nullptr;
+    if (vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("Could not map uniform ring memory");
+    }
+    mapped = static_cast<uint8_t*>(data);
+}
+
+void UniformRing::BeginFrame(size_t frameIndex) {
+    frameStart = frameSize * frameIndex;
+    head = frameStart;
+}
+
+void UniformRing::EndFrame() {
+    if (coherent || head == frameStart) {
+        return;
+    }
+    VkMappedMemoryRange range {};
+
+    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.memory = memory;
+    range.offset = frameStart;
+    range.size = std::min(AlignUp(head - frameStart, atomSize), frameSize);
+
+    vkFlushMappedMemoryRanges(device, 1, &range);
+}
+
+UniformAllocation UniformRing::Allocate(VkDeviceSize size) {
+    VkDeviceSize offset = AlignUp(head, alignment);
+
+    if (offset + size > frameStart + frameSize) {
+        throw std::runtime_error(FORMAT("Uniform ring exhausted, %llu bytes per frame",
+            static_cast<unsigned long long>(frameSize)));
+    }
+    head = offset + size;
+    return UniformAllocation { mapped + offset, static_cast<uint32_t>(offset) };
+}
+
+}
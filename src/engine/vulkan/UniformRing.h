@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+#include "Device.h"
+
+namespace engine::vulkan {
+
+struct UniformAllocation {
+    void*           data;
+    uint32_t        offset;
+};
+
+// One persistently mapped buffer split into a region per frame in flight.
+// Allocations are bumped from the current frame's region and addressed by
+// dynamic offset, so a single UNIFORM_BUFFER_DYNAMIC descriptor covers all of them.
+class UniformRing {
+
+public:
+                            UniformRing(const Device& device_,
+                                const VkAllocationCallbacks* allocator_,
+                                size_t frameCount_,
+                                VkDeviceSize frameSize_,
+                                VkBufferUsageFlags usage);
+                            ~UniformRing();
+
+    void                    BeginFrame(size_t frameIndex);
+    void                    EndFrame();
+    UniformAllocation       Allocate(VkDeviceSize size);
+
+    template<typename T>
+    uint32_t                Push(const T& value);
+
+    VkBuffer                GetBuffer() const { return buffer; }
+    VkDeviceSize            GetFrameSize() const { return frameSize; }
+    VkDeviceSize            GetAlignment() const { return alignment; }
+    VkDeviceSize            GetFrameUsage() const { return head - frameStart; }
+
+private:
+    VkDevice                        device;
+    const VkAllocationCallbacks*    allocator;
+    VkBuffer                        buffer;
+    VkDeviceMemory                  memory;
+    uint8_t*                        mapped;
+    bool                            coherent;
+    size_t                          frameCount;
+    VkDeviceSize                    alignment;
+    VkDeviceSize                    atomSize;
+    VkDeviceSize                    frameSize;
+    VkDeviceSize                    frameStart;
+    VkDeviceSize                    head;
+
+    void                    LoadBuffer(VkBufferUsageFlags usage);
+    void                    LoadMemory(const Device& device_);
+};
+
+template<typename T>
+uint32_t UniformRing::Push(const T& value) {
+    UniformAllocation alloc = Allocate(sizeof(T));
+    std::memcpy(alloc.data, &value, sizeof(T));
+    return alloc.offset;
+}
+
+}
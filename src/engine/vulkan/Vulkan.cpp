@@ -12,102 +12,370 @@ VKAPI_ATTR VkBool32 VKAPI_CALL DebugCallback(
     const char* msg,
     void* userData) {
 
-    WARN(msg);
+    auto filter = static_cast<DebugMessageFilter*>(userData);
+    DebugMessageDecision decision { filter->Filter(DebugMessageFilter::HashMessage(code, layerPrefix, msg), msg) };
+
+    if (decision.report) {
+        if (decision.suppressed > 0) {
+            BLOG_WARN(VALIDATION, "%s (repeated %u times)", msg, decision.suppressed);
+        } else {
+            BLOG_WARN(VALIDATION, "%s", msg);
+        }
+    }
 
     return VK_FALSE;
 }
 
-Vulkan::Vulkan(GLFWwindow* window):
+VKAPI_ATTR VkBool32 VKAPI_CALL DebugUtilsCallback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+    VkDebugUtilsMessageTypeFlagsEXT type,
+    const VkDebugUtilsMessengerCallbackDataEXT* callbackData,
+    void* userData) {
+
+    auto filter = static_cast<DebugMessageFilter*>(userData);
+    uint64_t messageId = DebugMessageFilter::HashMessage(callbackData->messageIdNumber,
+        callbackData->pMessageIdName,
+        callbackData->pMessage);
+    bool named = callbackData->messageIdNumber != 0 && callbackData->pMessageIdName != nullptr;
+    DebugMessageDecision decision { filter->Filter(messageId, named ? callbackData->pMessageIdName : callbackData->pMessage) };
+
+    if (!decision.report) {
+        return VK_FALSE;
+    }
+    bool error = (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) != 0;
+
+    if (decision.suppressed > 0 && error) {
+        BLOG_ERROR(VALIDATION, "%s (repeated %u times)", callbackData->pMessage, decision.suppressed);
+    } else if (decision.suppressed > 0) {
+        BLOG_WARN(VALIDATION, "%s (repeated %u times)", callbackData->pMessage, decision.suppressed);
+    } else if (error) {
+        BLOG_ERROR(VALIDATION, "%s", callbackData->pMessage);
+    } else {
+        BLOG_WARN(VALIDATION, "%s", callbackData->pMessage);
+    }
+    return VK_FALSE;
+}
+
+// Bindless needs vkGetPhysicalDeviceFeatures2 and friends, so ask for 1.1 when the loader has it
+static uint32_t GetInstanceApiVersion() {
+    auto enumerateVersion = (PFN_vkEnumerateInstanceVersion) vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion");
+    uint32_t version = VK_API_VERSION_1_0;
+
+    if (enumerateVersion != nullptr &&
+        enumerateVersion(&version) == VK_SUCCESS &&
+        version >= VK_API_VERSION_1_1) {
+        return VK_API_VERSION_1_1;
+    }
+    return VK_API_VERSION_1_0;
+}
+
+Vulkan::Vulkan(size_t windowCount, const WindowFactory& createWindows, io::AsyncIO& asyncIO):
+    hostAllocator { },
     instance { VK_NULL_HANDLE },
-    surface { VK_NULL_HANDLE },
-    imgAvailableSem { VK_NULL_HANDLE },
-    renderFinishedSem { VK_NULL_HANDLE },
+    apiVersion { VK_API_VERSION_1_0 },
+    debugCallback { VK_NULL_HANDLE },
+    debugMessenger { VK_NULL_HANDLE },
+    debugUtils { false },
+    currentFrame { 0 },
+    framesInFlight { 0 },
+    swapChainConfig { GetSwapChainPreset(SwapChainPreset::DEFAULT) },
+    configChanged { false },
+    swapChainGeneration { 0 },
     device { nullptr },
-    pipeline { nullptr }{
+    drawTexture { invalidTextureHandle } {
 
-    INFO("Initializing vulkan");
+    LOG_INFO(VULKAN, "Initializing vulkan");
     if (enableValidationLayers && !CheckValidationLayerSupport()) {
         throw std::runtime_error("Requested validation layers not available");
     }
-    LoadInstance();
-    SetupDebugCallback();
-    LoadSurface(window);
-    LoadDevice();
-    LoadSwapChain();
-    LoadPipeline();
-    LoadFramebuffers();
-    LoadCommandPools();
-    LoadSemaphores();
+    std::vector<GLFWwindow*> glfwWindows;
+    std::vector<VkExtent2D> windowExtents;
+    TaskGraph startup;
+
+    auto instanceTask = startup.Add("instance", [this]() {
+        LoadInstance();
+        SetupDebugCallback();
+    });
+    auto windowTask = startup.AddMainThread("windows", [&]() {
+        glfwWindows = createWindows();
+        if (glfwWindows.size() != windowCount) {
+            throw std::runtime_error(FORMAT("Could not create windows, expected %u, got %u", windowCount, glfwWindows.size()));
+        }
+        for (auto window: glfwWindows) {
+            int width = 0;
+            int height = 0;
+
+            glfwGetFramebufferSize(window, &width, &height);
+            windowExtents.push_back(VkExtent2D { static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
+        }
+    });
+    auto assetTask = startup.Add("assets", [this]() { LoadAssets(); });
+    auto surfaceTask = startup.Add("surfaces", [this, &glfwWindows]() { LoadSurfaces(glfwWindows); }, { instanceTask, windowTask });
+    auto deviceTask = startup.Add("device", [this]() { LoadDevice(); }, { surfaceTask });
+    auto bindlessTask = startup.Add("bindless", [this]() { LoadBindless(); }, { deviceTask });
+    auto targetTask = startup.Add("window targets", [this]() { LoadWindows(); }, { deviceTask });
+
+    // shaders and pipeline only need the surface format, not the swapchain images
+    for (size_t i = 0; i < windowCount; i++) {
+        auto pipelineTask = startup.Add(FORMAT("pipeline %u", i), [this, i]() {
+            windows[i]->LoadPipeline(bindless != nullptr ? bindless->GetLayout() : VK_NULL_HANDLE, assets.get());
+        }, { targetTask, bindlessTask, assetTask });
+        auto swapChainTask = startup.Add(FORMAT("swapchain %u", i), [this, i, &windowExtents]() {
+            windows[i]->LoadSwapChain(swapChainConfig, windowExtents[i]);
+        }, { targetTask });
+        startup.Add(FORMAT("framebuffers %u", i), [this, i]() { windows[i]->LoadFramebuffers(); }, { pipelineTask, swapChainTask });
+    }
+    startup.Add("command pools", [this]() { LoadCommandPools(); }, { deviceTask });
+    startup.Add("descriptor allocator", [this]() { LoadDescriptorAllocator(); }, { deviceTask });
+    startup.Add("uniform ring", [this]() { LoadUniformRing(); }, { deviceTask });
+    startup.Add("texture streamer", [this, &asyncIO]() { LoadTextureStreamer(asyncIO); }, { bindlessTask });
+    startup.Add("sync objects", [this]() { LoadSyncObjects(); }, { deviceTask });
+
+    ThreadPool pool { std::min(ThreadPool::GetDefaultThreadCount(), startupThreadCount) };
+    startup.Run(pool);
+    framesInFlight = std::min(std::max<size_t>(swapChainConfig.framesInFlight, 1), maxFramesInFlight);
+
+    for (const auto& timing: startup.GetTimings()) {
+        LOG_DEBUG(VULKAN, FORMAT("Startup %s: %.2f - %.2f ms",
+            timing.name,
+            std::chrono::duration<double, std::milli>(timing.start).count(),
+            std::chrono::duration<double, std::milli>(timing.end).count()));
+    }
+    LOG_INFO(VULKAN, FORMAT("Initialized vulkan in %.1f ms on %u threads",
+        std::chrono::duration<double, std::milli>(startup.GetDuration()).count(),
+        pool.GetThreadCount()));
 }
 
 Vulkan::~Vulkan() {
     vkDeviceWaitIdle(device->GetLogicalDevice());
 
-    vkDestroySemaphore(device->GetLogicalDevice(), renderFinishedSem, nullptr);
-    vkDestroySemaphore(device->GetLogicalDevice(), imgAvailableSem, nullptr);
+    for (auto fence: inFlightFences) {
+        vkDestroyFence(device->GetLogicalDevice(), fence, hostAllocator.GetCallbacks());
+    }
+    textureStreamer = nullptr;
+    uniformRing = nullptr;
+    descriptorAllocator = nullptr;
+    bindless = nullptr;
     commandPool = nullptr;
-    pipeline = nullptr;
-    swapchain = nullptr;
+    // also destroys the surfaces
+    windows.clear();
     device = nullptr;
-    vkDestroySurfaceKHR(instance, surface, nullptr);
-    DestroyDebugReportCallbackEXT(instance, debugCallback, nullptr);
-    vkDestroyInstance(instance, nullptr);
-    INFO("Destroyed vulkan");
+    if (debugMessenger != VK_NULL_HANDLE) {
+        DestroyDebugUtilsMessengerEXT(instance, debugMessenger, hostAllocator.GetCallbacks());
+    }
+    if (debugCallback != VK_NULL_HANDLE) {
+        DestroyDebugReportCallbackEXT(instance, debugCallback, hostAllocator.GetCallbacks());
+    }
+    if (debugFilter != nullptr) {
+        debugFilter->LogSummary();
+    }
+    vkDestroyInstance(instance, hostAllocator.GetCallbacks());
+    LOG_INFO(VULKAN, "Destroyed vulkan");
+    hostAllocator.LogStats();
+}
+
+// The triangle spans about the largest window, times the scale of the state
+static float GetDrawExtent(const FrameState& state) {
+    uint32_t extent = 0;
+
+    for (uint32_t i = 0; i < state.windowCount; i++) {
+        extent = std::max({ extent, state.windows[i].width, state.windows[i].height });
+    }
+    return state.scale * static_cast<float>(extent);
 }
 
-void Vulkan::DrawFrame() {
-    vkQueueWaitIdle(device->GetPresentQueue().GetQueue());
+bool Vulkan::DrawFrame(const FrameState& state) {
+    TRACE_SCOPE("Vulkan::DrawFrame");
+    if (configChanged.exchange(false)) {
+        ApplySwapChainConfig();
+    }
+    RecreateSwapChains(state);
+
+    VkFence frameFence = inFlightFences[currentFrame];
+    {
+        TRACE_SCOPE("Vulkan::WaitForFrameFence");
+        vkWaitForFences(device->GetLogicalDevice(), 1, &frameFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+    }
+
+    // the gpu is done with everything this frame slot allocated last time around
+    descriptorAllocator->BeginFrame(currentFrame);
+    if (bindless != nullptr) {
+        bindless->BeginFrame(currentFrame);
+    }
+    if (textureStreamer != nullptr) {
+        // a texture left unreported for a while drops back to its mip tail
+        if (drawTexture != invalidTextureHandle) {
+            textureStreamer->ReportUsage(drawTexture, GetDrawExtent(state));
+        }
+        textureStreamer->Update();
+    }
+    uniformRing->BeginFrame(currentFrame);
+
+    // minimized windows and swapchains gone out of date sit this frame out
+    activeWindows.clear();
+    for (size_t i = 0; i < windows.size() && i < state.windowCount; i++) {
+        if (state.windows[i].width == 0 || state.windows[i].height == 0 || windows[i]->IsDirty()) {
+            continue;
+        }
+        if (windows[i]->Acquire(currentFrame)) {
+            activeWindows.push_back(windows[i].get());
+        }
+    }
+    if (activeWindows.empty()) {
+        return false;
+    }
 
-    uint32_t imgIndex;
-    vkAcquireNextImageKHR(device->GetLogicalDevice(),
-        swapchain->GetSwapChain(),
-        std::numeric_limits<uint64_t>::max(),
-        imgAvailableSem,
-        VK_NULL_HANDLE,
-        &imgIndex);
+    DrawUniforms uniforms { { state.color[0], state.color[1], state.color[2], state.color[3] } };
+    draws.clear();
+    uint32_t textureIndex = drawTexture != invalidTextureHandle ? textureStreamer->GetBindlessIndex(drawTexture) : invalidBindlessIndex;
+    DrawPushConstants constants { { state.offset[0], state.offset[1] }, state.scale, { textureIndex, invalidBindlessIndex } };
+    draws.push_back(DrawCall { uniformRing->Push(uniforms), 3, constants });
+
+    waitSemaphores.clear();
+    waitStages.clear();
+    signalSemaphores.clear();
+    commandPool->BeginFrame(currentFrame);
+    for (auto target: activeWindows) {
+        const Pipeline& pipeline = target->GetPipeline();
+        VkDescriptorSet uniformSet = descriptorAllocator->GetSet(pipeline.GetDrawSetLayout(), {
+            CreateBufferBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, uniformRing->GetBuffer(), 0, sizeof(DrawUniforms)) });
+
+        commandPool->RecordWindow(currentFrame,
+            target->GetSwapChain(),
+            target->GetImageIndex(),
+            pipeline,
+            uniformSet,
+            bindless.get(),
+            target->GetPresentTransfer(),
+            draws);
+        waitSemaphores.push_back(target->GetImageAvailable(currentFrame));
+        waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+        signalSemaphores.push_back(target->GetRenderFinished());
+    }
+    commandPool->EndFrame(currentFrame);
+    uniformRing->EndFrame();
 
     VkSubmitInfo submitInfo {};
 
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    VkSemaphore waitSemaphores[] = { imgAvailableSem };
-    VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+    submitInfo.pWaitSemaphores = waitSemaphores.data();
+    submitInfo.pWaitDstStageMask = waitStages.data();
     submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = commandPool->GetCommandBufferPtr(imgIndex);
+    submitInfo.pCommandBuffers = commandPool->GetCommandBufferPtr(currentFrame);
+    submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+    submitInfo.pSignalSemaphores = signalSemaphores.data();
+
+    vkResetFences(device->GetLogicalDevice(), 1, &frameFence);
+    {
+        TRACE_SCOPE("Vulkan::SubmitFrame");
+        if (vkQueueSubmit(device->GetGraphicsQueue().GetQueue(), 1, &submitInfo, frameFence) != VK_SUCCESS) {
+            throw std::runtime_error("Could not submit draw command");
+        }
+    }
 
-    VkSemaphore signalSemaphores[] = { renderFinishedSem };
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
+    Present();
+    currentFrame = (currentFrame + 1) % framesInFlight;
+    return true;
+}
 
-    if (vkQueueSubmit(device->GetGraphicsQueue().GetQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
-        throw std::runtime_error("Could not submit draw command");
+void Vulkan::Present() {
+    TRACE_SCOPE("Vulkan::Present");
+    waitSemaphores.clear();
+    presentSwapChains.clear();
+    presentImages.clear();
+    for (auto target: activeWindows) {
+        waitSemaphores.push_back(target->SubmitPresentTransfer());
+        presentSwapChains.push_back(target->GetSwapChain().GetSwapChain());
+        presentImages.push_back(target->GetImageIndex());
     }
+    presentResults.assign(activeWindows.size(), VK_SUCCESS);
 
+    // one call for all windows, so they flip together and the driver sees a single present
     VkPresentInfoKHR presentInfo = {};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
+    presentInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+    presentInfo.pWaitSemaphores = waitSemaphores.data();
+    presentInfo.swapchainCount = static_cast<uint32_t>(presentSwapChains.size());
+    presentInfo.pSwapchains = presentSwapChains.data();
+    presentInfo.pImageIndices = presentImages.data();
+    presentInfo.pResults = presentResults.data();
+
+    VkResult result = vkQueuePresentKHR(device->GetPresentQueue().GetQueue(), &presentInfo);
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR) {
+        throw std::runtime_error("Could not present swapchain images");
+    }
+    for (size_t i = 0; i < activeWindows.size(); i++) {
+        if (presentResults[i] == VK_ERROR_OUT_OF_DATE_KHR || presentResults[i] == VK_SUBOPTIMAL_KHR) {
+            activeWindows[i]->MarkDirty();
+        }
+    }
+}
+
+void Vulkan::SetSwapChainConfig(const SwapChainConfig& config) {
+    std::lock_guard<std::mutex> lock { configMutex };
+    pendingConfig = config;
+    configChanged = true;
+}
+
+void Vulkan::ApplySwapChainConfig() {
+    std::lock_guard<std::mutex> lock { configMutex };
+    swapChainConfig = pendingConfig;
+    for (auto& target: windows) {
+        target->MarkDirty();
+    }
+}
+
+void Vulkan::RecreateSwapChains(const FrameState& state) {
+    bool idle = false;
+
+    for (size_t i = 0; i < windows.size() && i < state.windowCount; i++) {
+        const WindowState& window = state.windows[i];
 
-    VkSwapchainKHR swapChains[] = { swapchain->GetSwapChain() };
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imgIndex;
-    presentInfo.pResults = nullptr;
+        // a minimized window has nothing to present to, it is recreated once it comes back
+        if (!windows[i]->IsDirty() || window.width == 0 || window.height == 0) {
+            continue;
+        }
+        if (!idle) {
+            TRACE_SCOPE("Vulkan::WaitIdleForRecreate");
+            BLOG_DEBUG(VULKAN, "Recreate swapchains");
+            vkDeviceWaitIdle(device->GetLogicalDevice());
+            idle = true;
+        }
+        windows[i]->LoadSwapChain(swapChainConfig, VkExtent2D { window.width, window.height });
+        windows[i]->LoadFramebuffers();
+    }
+    if (!idle) {
+        return;
+    }
 
-    vkQueuePresentKHR(device->GetPresentQueue().GetQueue(), &presentInfo);
+    // nothing is in flight anymore, so slots the new frame count skips can be released now
+    for (size_t i = 0; i < maxFramesInFlight; i++) {
+        descriptorAllocator->BeginFrame(i);
+        if (bindless != nullptr) {
+            bindless->BeginFrame(i);
+        }
+    }
+    framesInFlight = std::min(std::max<size_t>(swapChainConfig.framesInFlight, 1), maxFramesInFlight);
+    currentFrame = 0;
+    swapChainGeneration++;
+    BLOG_INFO(VULKAN, "Swapchains recreated, %s, %u images, %u frames in flight",
+        GetPresentModeName(GetPresentMode()), GetSwapChainImageCount(), framesInFlight);
 }
 
 void Vulkan::LoadInstance() {
-    DEBUG("Load instance");
+    TRACE_SCOPE("Vulkan::LoadInstance");
+    LOG_DEBUG(VULKAN, "Load instance");
+    apiVersion = GetInstanceApiVersion();
+    debugUtils = enableValidationLayers && IsInstanceExtensionAvailable(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+
     VkApplicationInfo appInfo {};
     appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
     appInfo.pApplicationName = "Test-Vulkan";
     appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.pEngineName = "roflcopter";
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    appInfo.apiVersion = VK_API_VERSION_1_0;
+    appInfo.apiVersion = apiVersion;
 
     VkInstanceCreateInfo createInfo {};
     createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -121,90 +389,179 @@ void Vulkan::LoadInstance() {
         createInfo.enabledLayerCount = 0;
     }
 
-    auto extensions = GetRequiredExtensions();
+    auto extensions = GetRequiredExtensions(debugUtils);
     createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
     createInfo.ppEnabledExtensionNames = extensions.data();
 
-    if (vkCreateInstance(&createInfo, nullptr, &instance) != VK_SUCCESS) {
+    if (vkCreateInstance(&createInfo, hostAllocator.GetCallbacks(), &instance) != VK_SUCCESS) {
         throw std::runtime_error("Could not create vulkan instance");
     }
 }
 
 void Vulkan::SetupDebugCallback() {
-    DEBUG("Setup debug callback");
-    if (enableValidationLayers) {
+    TRACE_SCOPE("Vulkan::SetupDebugCallback");
+    LOG_DEBUG(VULKAN, "Setup debug callback");
+    if (enableValidationLayers && debugUtils) {
+        debugFilter = std::make_unique<DebugMessageFilter>(validationReportInterval);
+
+        VkDebugUtilsMessengerCreateInfoEXT createInfo {};
+        createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+        createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT |
+                       VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+        createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
+                       VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
+                       VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+        createInfo.pfnUserCallback = DebugUtilsCallback;
+        createInfo.pUserData = debugFilter.get();
+
+        if (CreateDebugUtilsMessengerEXT(instance, &createInfo, hostAllocator.GetCallbacks(), &debugMessenger) != VK_SUCCESS) {
+            throw std::runtime_error("Could not set up debug messenger");
+        }
+    }
+    else if (enableValidationLayers) {
+        debugFilter = std::make_unique<DebugMessageFilter>(validationReportInterval);
+
         VkDebugReportCallbackCreateInfoEXT createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_REPORT_CALLBACK_CREATE_INFO_EXT;
         createInfo.flags = VK_DEBUG_REPORT_ERROR_BIT_EXT |
                        VK_DEBUG_REPORT_WARNING_BIT_EXT;
         createInfo.pfnCallback = DebugCallback;
+        createInfo.pUserData = debugFilter.get();
 
-        if (CreateDebugReportCallbackEXT(instance, &createInfo, nullptr, &debugCallback) != VK_SUCCESS) {
+        if (CreateDebugReportCallbackEXT(instance, &createInfo, hostAllocator.GetCallbacks(), &debugCallback) != VK_SUCCESS) {
             throw std::runtime_error("Could not set up debug callback");
         }
     }
 }
 
-void Vulkan::LoadSurface(GLFWwindow* window) {
-    DEBUG("Load surface");
-    if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS) {
-        throw std::runtime_error("Could not create window surface");
+void Vulkan::LoadSurfaces(const std::vector<GLFWwindow*>& glfwWindows) {
+    TRACE_SCOPE("Vulkan::LoadSurfaces");
+    LOG_DEBUG(VULKAN, "Load surfaces");
+    for (auto window: glfwWindows) {
+        VkSurfaceKHR surface = VK_NULL_HANDLE;
+
+        if (glfwCreateWindowSurface(instance, window, hostAllocator.GetCallbacks(), &surface) != VK_SUCCESS) {
+            throw std::runtime_error("Could not create window surface");
+        }
+        surfaces.push_back(surface);
     }
 }
 
 void Vulkan::LoadDevice() {
-    DEBUG("Load device");
-    auto devices = GetDevices(instance, surface);
-
-    for (auto& currDev: devices) {
-        if (currDev.QueuesComplete() && currDev.SupportsRequiredExtensions()) {
-            device = std::make_unique<Device>(std::move(currDev));
-            device->LoadLogicalDevice();
-            INFO(StringFormat("Used device: %s", device->GetName().c_str()));
-            break;
-        }
-    }
-    if (device == nullptr) {
-        throw std::runtime_error("Could not find appropriate device");
-    }
+    TRACE_SCOPE("Vulkan::LoadDevice");
+    LOG_DEBUG(VULKAN, "Load device");
+    bool bindlessAvailable = preferBindless && apiVersion >= VK_API_VERSION_1_1;
+    auto devices = GetDevices(instance, surfaces[0], hostAllocator.GetCallbacks());
+    size_t index = SelectDevice(devices, surfaces, apiVersion, bindlessAvailable);
+
+    device = std::make_unique<Device>(std::move(devices[index]));
+    device->LoadLogicalDevice(bindlessAvailable && device->SupportsDescriptorIndexing());
 }
 
-void Vulkan::LoadSwapChain() {
-    DEBUG("Load swapchain");
-    swapchain = device->CreateSwapChain(surface);
+void Vulkan::LoadBindless() {
+    TRACE_SCOPE("Vulkan::LoadBindless");
+    LOG_DEBUG(VULKAN, "Load bindless");
+    if (!device->IsBindlessEnabled()) {
+        return;
+    }
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT limits { device->GetDescriptorIndexingProperties() };
+    uint32_t textureCapacity = std::min({ 4096u,
+        limits.maxDescriptorSetUpdateAfterBindSampledImages,
+        limits.maxPerStageDescriptorUpdateAfterBindSampledImages });
+    uint32_t bufferCapacity = std::min({ 1024u,
+        limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+        limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+
+    bindless = std::make_unique<BindlessTable>(device->GetLogicalDevice(),
+        hostAllocator.GetCallbacks(),
+        maxFramesInFlight,
+        textureCapacity,
+        bufferCapacity);
 }
 
-void Vulkan::LoadPipeline() {
-    DEBUG("Load pipeline");
-    pipeline = std::make_unique<Pipeline>(device->GetLogicalDevice(),
-        swapchain->GetImageExtent(),
-        swapchain->GetImageFormat());
+void Vulkan::LoadAssets() {
+    TRACE_SCOPE("Vulkan::LoadAssets");
+    LOG_DEBUG(VULKAN, "Load assets");
+    if (!FileExists(assetArchiveFilename)) {
+        LOG_WARN(VULKAN, FORMAT("No asset archive %s, loading assets from loose files", assetArchiveFilename));
+        return;
+    }
+    assets = std::make_unique<AssetArchive>(assetArchiveFilename);
+    LOG_INFO(VULKAN, FORMAT("Loaded asset archive %s, %u entries", assetArchiveFilename, assets->GetEntryCount()));
 }
 
-void Vulkan::LoadFramebuffers() {
-    DEBUG("Load framebuffers");
-    swapchain->LoadFramebuffers(pipeline->GetRenderPass());
+void Vulkan::LoadWindows() {
+    TRACE_SCOPE("Vulkan::LoadWindows");
+    LOG_DEBUG(VULKAN, "Load windows");
+    for (auto surface: surfaces) {
+        windows.push_back(std::make_unique<WindowTarget>(instance, *device, hostAllocator.GetCallbacks(), surface));
+    }
+    // owned by the windows from here on
+    surfaces.clear();
 }
 
 void Vulkan::LoadCommandPools() {
-    DEBUG("Load command pools");
-    commandPool = std::make_unique<CommandPool>(device->GetLogicalDevice(), device->GetGraphicsQueue());
-    commandPool->LoadCommandBuffers(*swapchain);
-    commandPool->RecordCommand(*swapchain, *pipeline);
+    TRACE_SCOPE("Vulkan::LoadCommandPools");
+    LOG_DEBUG(VULKAN, "Load command pools");
+    commandPool = std::make_unique<CommandPool>(device->GetLogicalDevice(), hostAllocator.GetCallbacks(), device->GetGraphicsQueue());
+    commandPool->LoadCommandBuffers(maxFramesInFlight);
 }
 
-void Vulkan::LoadSemaphores() {
-    DEBUG("Load semaphores");
-    VkSemaphoreCreateInfo createInfo {};
+void Vulkan::LoadDescriptorAllocator() {
+    TRACE_SCOPE("Vulkan::LoadDescriptorAllocator");
+    LOG_DEBUG(VULKAN, "Load descriptor allocator");
+    descriptorAllocator = std::make_unique<DescriptorAllocator>(device->GetLogicalDevice(),
+        hostAllocator.GetCallbacks(),
+        maxFramesInFlight);
+}
 
-    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+void Vulkan::LoadUniformRing() {
+    TRACE_SCOPE("Vulkan::LoadUniformRing");
+    LOG_DEBUG(VULKAN, "Load uniform ring");
+    uniformRing = std::make_unique<UniformRing>(*device,
+        hostAllocator.GetCallbacks(),
+        maxFramesInFlight,
+        uniformRingFrameSize,
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+}
 
-    if (vkCreateSemaphore(device->GetLogicalDevice(), &createInfo, nullptr, &imgAvailableSem) != VK_SUCCESS) {
-        throw std::runtime_error("Could not create img available semaphore");
+void Vulkan::LoadTextureStreamer(io::AsyncIO& asyncIO) {
+    TRACE_SCOPE("Vulkan::LoadTextureStreamer");
+    LOG_DEBUG(VULKAN, "Load texture streamer");
+    // streamed textures are only addressed through the bindless table
+    if (bindless == nullptr) {
+        LOG_WARN(VULKAN, "No bindless table, texture streaming disabled");
+        return;
+    }
+    textureStreamer = std::make_unique<TextureStreamer>(*device,
+        hostAllocator.GetCallbacks(),
+        *bindless,
+        asyncIO,
+        maxFramesInFlight,
+        defaultTextureStreamingConfig);
+
+    // only queued here, the first PumpIO after startup submits it
+    const char* texture = std::getenv(textureEnvVar);
+    if (texture != nullptr && *texture != 0) {
+        LOG_INFO(TEXTURES, FORMAT("Streaming %s from %s", texture, textureEnvVar));
+        drawTexture = textureStreamer->Load(texture);
     }
+}
+
+void Vulkan::LoadSyncObjects() {
+    TRACE_SCOPE("Vulkan::LoadSyncObjects");
+    LOG_DEBUG(VULKAN, "Load sync objects");
+    VkFenceCreateInfo fenceCreateInfo {};
+
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    if (vkCreateSemaphore(device->GetLogicalDevice(), &createInfo, nullptr, &renderFinishedSem) != VK_SUCCESS) {
-        throw std::runtime_error("Could not create render finished semaphore");
+    inFlightFences.resize(maxFramesInFlight, VK_NULL_HANDLE);
+
+    for (size_t i = 0; i < maxFramesInFlight; i++) {
+        if (vkCreateFence(device->GetLogicalDevice(), &fenceCreateInfo, hostAllocator.GetCallbacks(), &inFlightFences[i]) != VK_SUCCESS) {
+            throw std::runtime_error("Could not create in flight fence");
+        }
     }
 }
 
@@ -2,52 +2,126 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
 
 #include <vulkan/vulkan.h>
 #include <GLFW/glfw3.h>
 
 #include "logging/StdLogger.h"
-#include "utility/StringFormat.h"
+#include "utility/Format.h"
+#include "utility/AssetArchive.h"
+#include "utility/ThreadPool.h"
+#include "utility/TaskGraph.h"
+#include "engine/FrameState.h"
 #include "initialization/ValidationLayer.h"
 #include "initialization/Extension.h"
 
+#include "HostAllocator.h"
 #include "Device.h"
+#include "DeviceSelection.h"
 #include "SwapChain.h"
 #include "Pipeline.h"
 #include "CommandPool.h"
+#include "DescriptorAllocator.h"
+#include "BindlessTable.h"
+#include "UniformRing.h"
+#include "DebugMessageFilter.h"
+#include "StagingUploader.h"
+#include "TextureStreamer.h"
+#include "PresentTransfer.h"
+#include "WindowTarget.h"
 
 namespace engine::vulkan {
 
+const VkDeviceSize uniformRingFrameSize = 64 * 1024;
+
+const char* const assetArchiveFilename = "assets.pack";
+
+// The startup graph is rarely wider than this, more threads would sit idle
+const size_t startupThreadCount = 4;
+
+// Creates the glfw windows to draw to, called on the thread constructing Vulkan
+typedef std::function<std::vector<GLFWwindow*>()> WindowFactory;
+
 class Vulkan {
 
 public:
-    explicit                        Vulkan(GLFWwindow* window);
+    // Initialization runs as a task graph, so the windows are created while the
+    // instance and assets load, and pipelines build while swapchains are created
+                                    Vulkan(size_t windowCount, const WindowFactory& createWindows, io::AsyncIO& asyncIO);
                                     ~Vulkan();
 
-    void                            DrawFrame();
+    // Draws to every window with a framebuffer, false if nothing was presented
+    bool                            DrawFrame(const FrameState& state);
+    // Safe from any thread, the swapchains are recreated before the next frame
+    void                            SetSwapChainConfig(const SwapChainConfig& config);
+    VkPresentModeKHR                GetPresentMode(size_t window = 0) const { return windows[window]->GetSwapChain().GetPresentMode(); }
+    size_t                          GetSwapChainImageCount(size_t window = 0) const { return windows[window]->GetSwapChain().GetImageCount(); }
+    size_t                          GetWindowCount() const { return windows.size(); }
+    size_t                          GetFramesInFlight() const { return framesInFlight; }
+    // Counts swapchain recreations, so frame statistics can be split per configuration
+    uint32_t                        GetSwapChainGeneration() const { return swapChainGeneration; }
+    HostAllocationStats             GetHostAllocationStats() const { return hostAllocator.GetStats(); }
+    TextureStreamer*                GetTextureStreamer() { return textureStreamer.get(); }
 
 private:
 
     void                            LoadInstance();
     void                            SetupDebugCallback();
-    void                            LoadSurface(GLFWwindow* window);
+    void                            LoadSurfaces(const std::vector<GLFWwindow*>& glfwWindows);
     void                            LoadDevice();
-    void                            LoadSwapChain();
-    void                            LoadPipeline();
-    void                            LoadFramebuffers();
+    void                            LoadBindless();
+    void                            LoadAssets();
+    void                            LoadWindows();
     void                            LoadCommandPools();
-    void                            LoadSemaphores();
+    void                            LoadDescriptorAllocator();
+    void                            LoadUniformRing();
+    void                            LoadTextureStreamer(io::AsyncIO& asyncIO);
+    void                            LoadSyncObjects();
+    void                            ApplySwapChainConfig();
+    void                            RecreateSwapChains(const FrameState& state);
+    void                            Present();
 
+    HostAllocator                   hostAllocator;
     VkInstance                      instance;
+    uint32_t                        apiVersion;
     VkDebugReportCallbackEXT        debugCallback;
-    VkSurfaceKHR                    surface;
-    VkSemaphore                     imgAvailableSem;
-    VkSemaphore                     renderFinishedSem;
+    VkDebugUtilsMessengerEXT        debugMessenger;
+    bool                            debugUtils;
+    std::unique_ptr<DebugMessageFilter> debugFilter;
+    std::vector<VkSurfaceKHR>       surfaces;
+    std::vector<VkFence>            inFlightFences;
+    size_t                          currentFrame;
+    size_t                          framesInFlight;
+    SwapChainConfig                 swapChainConfig;
+    std::mutex                      configMutex;
+    SwapChainConfig                 pendingConfig;
+    std::atomic<bool>               configChanged;
+    uint32_t                        swapChainGeneration;
+    // windows drawn in the current frame, and the batched present built from them
+    std::vector<WindowTarget*>      activeWindows;
+    std::vector<VkSemaphore>        waitSemaphores;
+    std::vector<VkPipelineStageFlags>   waitStages;
+    std::vector<VkSemaphore>        signalSemaphores;
+    std::vector<VkSwapchainKHR>     presentSwapChains;
+    std::vector<uint32_t>           presentImages;
+    std::vector<VkResult>           presentResults;
+    std::vector<DrawCall>           draws;
 
+    std::unique_ptr<AssetArchive>   assets;
     std::unique_ptr<Device>         device;
-    std::unique_ptr<SwapChain>      swapchain;
-    std::unique_ptr<Pipeline>       pipeline;
+    std::vector<std::unique_ptr<WindowTarget>>  windows;
     std::unique_ptr<CommandPool>    commandPool;
+    std::unique_ptr<DescriptorAllocator>    descriptorAllocator;
+    std::unique_ptr<BindlessTable>  bindless;
+    std::unique_ptr<UniformRing>    uniformRing;
+    std::unique_ptr<TextureStreamer>    textureStreamer;
+    // loaded from textureEnvVar, invalidTextureHandle without one
+    TextureHandle                   drawTexture;
 };
 
 
@@ -0,0 +1,127 @@
+#include "WindowTarget.h"
+
+namespace engine::vulkan {
+
+WindowTarget::WindowTarget(VkInstance instance_, const Device& device_, const VkAllocationCallbacks* allocator_, VkSurfaceKHR surface_):
+    instance { instance_ },
+    device { device_ },
+    allocator { allocator_ },
+    surface { surface_ },
+    surfaceFormat { device.GetSurfaceFormat(surface) },
+    bindlessLayout { VK_NULL_HANDLE },
+    assets { nullptr },
+    imageIndex { 0 },
+    dirty { true } {
+
+    LoadSemaphores();
+}
+
+WindowTarget::~WindowTarget() {
+    for (auto semaphore: imgAvailableSems) {
+        vkDestroySemaphore(device.GetLogicalDevice(), semaphore, allocator);
+    }
+    DestroyRenderFinishedSemaphores();
+    presentTransfer = nullptr;
+    swapchain = nullptr;
+    pipeline = nullptr;
+    vkDestroySurfaceKHR(instance, surface, allocator);
+}
+
+void WindowTarget::LoadSemaphores() {
+    VkSemaphoreCreateInfo createInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    imgAvailableSems.resize(maxFramesInFlight, VK_NULL_HANDLE);
+
+    for (size_t i = 0; i < maxFramesInFlight; i++) {
+        if (vkCreateSemaphore(device.GetLogicalDevice(), &createInfo, allocator, &imgAvailableSems[i]) != VK_SUCCESS) {
+            throw std::runtime_error("Could not create img available semaphore");
+        }
+    }
+}
+
+// Only called with nothing in flight, on startup or after the recreate wait
+void WindowTarget::LoadRenderFinishedSemaphores() {
+    VkSemaphoreCreateInfo createInfo {};
+
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    DestroyRenderFinishedSemaphores();
+    renderFinishedSems.resize(swapchain->GetImageCount(), VK_NULL_HANDLE);
+
+    for (size_t i = 0; i < renderFinishedSems.size(); i++) {
+        if (vkCreateSemaphore(device.GetLogicalDevice(), &createInfo, allocator, &renderFinishedSems[i]) != VK_SUCCESS) {
+            throw std::runtime_error("Could not create render finished semaphore");
+        }
+    }
+}
+
+void WindowTarget::DestroyRenderFinishedSemaphores() {
+    for (auto semaphore: renderFinishedSems) {
+        vkDestroySemaphore(device.GetLogicalDevice(), semaphore, allocator);
+    }
+    renderFinishedSems.clear();
+}
+
+void WindowTarget::LoadPipeline(VkDescriptorSetLayout bindlessLayout_, const AssetArchive* assets_) {
+    TRACE_SCOPE("WindowTarget::LoadPipeline");
+    bindlessLayout = bindlessLayout_;
+    assets = assets_;
+    pipeline = std::make_unique<Pipeline>(device.GetLogicalDevice(), allocator, surfaceFormat, bindlessLayout, assets);
+}
+
+void WindowTarget::LoadSwapChain(const SwapChainConfig& config, VkExtent2D windowExtent) {
+    TRACE_SCOPE("WindowTarget::LoadSwapChain");
+    VkSwapchainKHR oldSwapChain = swapchain != nullptr ? swapchain->GetSwapChain() : VK_NULL_HANDLE;
+
+    presentTransfer = nullptr;
+    swapchain = device.CreateSwapChain(surface, config, windowExtent, oldSwapChain);
+    dirty = true;
+    LoadRenderFinishedSemaphores();
+
+    if (device.UsesQueueOwnershipTransfer()) {
+        presentTransfer = std::make_unique<PresentTransfer>(device, allocator, *swapchain);
+    } else if (device.GetGraphicsQueue().GetIndex() != device.GetPresentQueue().GetIndex()) {
+        LOG_DEBUG(SWAPCHAIN, "Swapchain images shared concurrently by graphics and present queue");
+    }
+}
+
+void WindowTarget::LoadFramebuffers() {
+    TRACE_SCOPE("WindowTarget::LoadFramebuffers");
+    // the render pass is baked into the pipeline, the extent is not
+    VkSurfaceFormatKHR format = swapchain->GetImageFormat();
+    if (format.format != surfaceFormat.format || format.colorSpace != surfaceFormat.colorSpace) {
+        LOG_DEBUG(PIPELINE, "Surface format changed, rebuilding pipeline");
+        surfaceFormat = format;
+        LoadPipeline(bindlessLayout, assets);
+    }
+    swapchain->LoadFramebuffers(pipeline->GetRenderPass());
+    dirty = false;
+}
+
+bool WindowTarget::Acquire(size_t frameIndex) {
+    TRACE_SCOPE("WindowTarget::Acquire");
+    VkResult result = vkAcquireNextImageKHR(device.GetLogicalDevice(),
+        swapchain->GetSwapChain(),
+        std::numeric_limits<uint64_t>::max(),
+        imgAvailableSems[frameIndex],
+        VK_NULL_HANDLE,
+        &imageIndex);
+
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+        dirty = true;
+        return false;
+    }
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+        throw std::runtime_error("Could not acquire swapchain image");
+    }
+    return true;
+}
+
+VkSemaphore WindowTarget::SubmitPresentTransfer() {
+    if (presentTransfer == nullptr) {
+        return renderFinishedSems[imageIndex];
+    }
+    return presentTransfer->Submit(imageIndex, renderFinishedSems[imageIndex]);
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+
+#include <vulkan/vulkan.h>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+#include "utility/AssetArchive.h"
+#include "Device.h"
+#include "SwapChain.h"
+#include "Pipeline.h"
+#include "PresentTransfer.h"
+
+namespace engine::vulkan {
+
+// The part of the renderer owned by one window: surface, swapchain, the
+// pipeline built for its format, its image available semaphores per frame slot
+// and its render finished semaphores per swapchain image. Instance, device and
+// per frame resources are shared by all windows.
+// Pipeline and swapchain do not depend on each other and may be loaded from
+// two threads at once, LoadFramebuffers joins them.
+class WindowTarget {
+
+public:
+                                WindowTarget(VkInstance instance_,
+                                    const Device& device_,
+                                    const VkAllocationCallbacks* allocator_,
+                                    VkSurfaceKHR surface_);
+                                ~WindowTarget();
+
+    // Builds the pipeline for the format the surface reports
+    void                        LoadPipeline(VkDescriptorSetLayout bindlessLayout_, const AssetArchive* assets_);
+    // Hands the old swapchain over if there is one, the framebuffers follow with LoadFramebuffers
+    void                        LoadSwapChain(const SwapChainConfig& config, VkExtent2D windowExtent);
+    // Rebuilds the pipeline if the swapchain got another format, the target is drawable afterwards
+    void                        LoadFramebuffers();
+    // False if the swapchain is out of date, it is marked for recreation then
+    bool                        Acquire(size_t frameIndex);
+    // The semaphore to present on, after handing the image to the present family where needed
+    VkSemaphore                 SubmitPresentTransfer();
+    void                        MarkDirty() { dirty = true; }
+    bool                        IsDirty() const { return dirty; }
+
+    uint32_t                    GetImageIndex() const { return imageIndex; }
+    VkSemaphore                 GetImageAvailable(size_t frameIndex) const { return imgAvailableSems[frameIndex]; }
+    // Per acquired image, a present may still wait on it when the frame slot comes around again
+    VkSemaphore                 GetRenderFinished() const { return renderFinishedSems[imageIndex]; }
+    const SwapChain&            GetSwapChain() const { return *swapchain; }
+    const Pipeline&             GetPipeline() const { return *pipeline; }
+    const PresentTransfer*      GetPresentTransfer() const { return presentTransfer.get(); }
+
+private:
+    VkInstance                          instance;
+    const Device&                       device;
+    const VkAllocationCallbacks*        allocator;
+    VkSurfaceKHR                        surface;
+    VkSurfaceFormatKHR                  surfaceFormat;
+    VkDescriptorSetLayout               bindlessLayout;
+    const AssetArchive*                 assets;
+    std::unique_ptr<SwapChain>          swapchain;
+    std::unique_ptr<PresentTransfer>    presentTransfer;
+    std::unique_ptr<Pipeline>           pipeline;
+    std::vector<VkSemaphore>            imgAvailableSems;
+    std::vector<VkSemaphore>            renderFinishedSems;
+    uint32_t                            imageIndex;
+    bool                                dirty;
+
+    void                        LoadSemaphores();
+    void                        LoadRenderFinishedSemaphores();
+    void                        DestroyRenderFinishedSemaphores();
+};
+
+}
@@ -16,7 +16,22 @@ void ListAvailableVulkanExtensions() {
   }
 }
 
-std::vector<const char*> GetRequiredExtensions() {
+bool IsInstanceExtensionAvailable(const char* name) {
+  uint32_t extCount = 0;
+
+  vkEnumerateInstanceExtensionProperties(nullptr, &extCount, nullptr);
+  std::vector<VkExtensionProperties> extensions(extCount);
+  vkEnumerateInstanceExtensionProperties(nullptr, &extCount, extensions.data());
+
+  for (const auto& e: extensions) {
+    if (strcmp(e.extensionName, name) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<const char*> GetRequiredExtensions(bool debugUtils) {
   std::vector<const char*> extensions;
 
   unsigned int glfwExtCount = 0;
@@ -27,7 +42,7 @@ std::vector<const char*> GetRequiredExtensions() {
   }
 
   if (enableValidationLayers) {
-    extensions.push_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
+    extensions.push_back(debugUtils ? VK_EXT_DEBUG_UTILS_EXTENSION_NAME : VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
   }
 
   return extensions;
@@ -13,6 +13,7 @@
 namespace engine::vulkan {
 
 void ListAvailableVulkanExtensions();
-std::vector<const char*> GetRequiredExtensions();
+bool IsInstanceExtensionAvailable(const char* name);
+std::vector<const char*> GetRequiredExtensions(bool debugUtils);
 
 }
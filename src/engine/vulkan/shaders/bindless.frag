@@ -0,0 +1,33 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier : enable
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+layout(set = 1, binding = 1) readonly buffer Buffers {
+    vec4 color;
+} buffers[];
+
+// shares the block with shader.vert, the first 12 bytes belong to the vertex stage
+layout(push_constant) uniform BindlessIndices {
+    layout(offset = 12) uint textureIndex;
+    uint bufferIndex;
+} indices;
+
+layout(location = 0) in vec4 fragColor;
+
+layout(location = 0) out vec4 outColor;
+
+const uint invalidIndex = 0xFFFFFFFFu;
+
+void main() {
+    vec4 color = fragColor;
+
+    if (indices.bufferIndex != invalidIndex) {
+        color = buffers[indices.bufferIndex].color;
+    }
+    if (indices.textureIndex != invalidIndex) {
+        vec2 uv = gl_FragCoord.xy / vec2(textureSize(textures[indices.textureIndex], 0));
+        color *= texture(textures[indices.textureIndex], uv);
+    }
+    outColor = color;
+}
@@ -1,6 +1,17 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+layout(set = 0, binding = 0) uniform DrawUniforms {
+    vec4 color;
+} draw;
+
+layout(push_constant) uniform DrawPushConstants {
+    vec2 offset;
+    float scale;
+} constants;
+
+layout(location = 0) out vec4 fragColor;
+
 out gl_PerVertex {
     vec4 gl_Position;
 };
@@ -12,5 +23,6 @@ vec2 positions[3] = vec2[](
 );
 
 void main() {
-    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+    gl_Position = vec4(positions[gl_VertexIndex] * constants.scale + constants.offset, 0.0, 1.0);
+    fragColor = draw.color;
 }
@@ -0,0 +1,307 @@
+#include "AsyncIO.h"
+
+#include <fstream>
+#include <cstring>
+#include <cerrno>
+
+#ifdef IO_URING_AVAILABLE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+namespace io {
+
+// user data of the nop which wakes the reaper for shutdown, requests use their address
+static const uint64_t wakeUserData = 0;
+
+AsyncIO::AsyncIO(const AsyncIOConfig& config_):
+    config { config_ },
+    backend { IoBackend::THREAD_POOL },
+    nextId { 1 },
+    inFlight { 0 },
+    ringQueued { 0 },
+    reaping { false } {
+
+    if (config.preferIoUring && IoUring::IsSupported()) {
+        try {
+            ring = std::make_unique<IoUring>(config.queueDepth);
+            backend = IoBackend::IO_URING;
+            reaper = std::thread { &AsyncIO::Reap, this };
+        }
+        catch (const std::runtime_error& e) {
+            LOG_WARN(IO, e.what());
+            ring = nullptr;
+        }
+    }
+    if (backend == IoBackend::THREAD_POOL) {
+        pool = std::make_unique<ThreadPool>(config.workerCount);
+    }
+    LOG_INFO(IO, FORMAT("Async I/O using %s, queue depth %u", GetBackendName(), config.queueDepth));
+}
+
+AsyncIO::~AsyncIO() {
+    // reads still in flight write into requests we own, let them finish without running callbacks
+    {
+        std::unique_lock<std::mutex> lock { completedMutex };
+        completedSignal.wait(lock, [this]() { return inFlight.load(std::memory_order_acquire) == 0; });
+    }
+    if (ring != nullptr) {
+        #ifdef IO_URING_AVAILABLE
+        std::lock_guard<std::mutex> lock { ringMutex };
+        ring->PrepareNop(wakeUserData);
+        ring->Submit();
+        #endif
+    }
+    if (reaper.joinable()) {
+        reaper.join();
+    }
+    pool = nullptr;
+    LOG_DEBUG(IO, "Destroyed async I/O");
+    stats.Log();
+}
+
+const char* AsyncIO::GetBackendName() const {
+    return backend == IoBackend::IO_URING ? "io_uring" : "thread pool";
+}
+
+uint64_t AsyncIO::Read(const std::string& filename, ReadCallback callback, uint64_t offset, size_t size) {
+    std::unique_ptr<Request> request { new Request {} };
+
+    request->id = nextId++;
+    request->filename = filename;
+    request->offset = offset;
+    request->size = size;
+    request->callback = std::move(callback);
+    request->fd = -1;
+    request->done = 0;
+    batch.push_back(std::move(request));
+    return batch.back()->id;
+}
+
+void AsyncIO::Submit() {
+    if (batch.empty()) {
+        return;
+    }
+    for (auto& request: batch) {
+        request->start = std::chrono::steady_clock::now();
+        stats.RecordSubmit();
+        inFlight.fetch_add(1, std::memory_order_acq_rel);
+
+        if (backend == IoBackend::THREAD_POOL) {
+            Request* pending = request.release();
+            pool->Enqueue([this, pending]() { ReadBlocking(std::unique_ptr<Request> { pending }); });
+        } else if (!Open(*request)) {
+            Fail(std::move(request), std::strerror(errno));
+        } else if (request->size == 0) {
+            Complete(std::move(request));
+        } else {
+            QueueRing(request.release());
+        }
+    }
+    batch.clear();
+
+    if (ring != nullptr) {
+        std::lock_guard<std::mutex> lock { ringMutex };
+        FillRing();
+    }
+}
+
+size_t AsyncIO::Poll() {
+    std::vector<std::unique_ptr<Request>> finished;
+
+    {
+        std::lock_guard<std::mutex> lock { completedMutex };
+        finished.swap(completed);
+    }
+    for (auto& request: finished) {
+        if (request->callback) {
+            request->callback(request->result);
+        }
+    }
+    return finished.size();
+}
+
+void AsyncIO::WaitIdle() {
+    Submit();
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock { completedMutex };
+            completedSignal.wait(lock, [this]() {
+                return !completed.empty() || inFlight.load(std::memory_order_acquire) == 0;
+            });
+        }
+        Poll();
+        if (inFlight.load(std::memory_order_acquire) == 0) {
+            Poll();
+            return;
+        }
+    }
+}
+
+void AsyncIO::Complete(std::unique_ptr<Request> request) {
+    ReadResult& result = request->result;
+
+    #ifdef IO_URING_AVAILABLE
+    if (request->fd >= 0) {
+        close(request->fd);
+        request->fd = -1;
+    }
+    #endif
+    result.id = request->id;
+    result.filename = request->filename;
+    result.offset = request->offset;
+    if (result.error.empty()) {
+        result.success = true;
+    }
+    stats.RecordComplete(result.data.size(), std::chrono::steady_clock::now() - request->start, result.success);
+
+    std::lock_guard<std::mutex> lock { completedMutex };
+    completed.push_back(std::move(request));
+    inFlight.fetch_sub(1, std::memory_order_acq_rel);
+    completedSignal.notify_all();
+}
+
+void AsyncIO::Fail(std::unique_ptr<Request> request, const std::string& error) {
+    BLOG_WARN(IO, "Could not read %s: %s", request->filename, error);
+    request->result.success = false;
+    request->result.error = error;
+    request->result.data.clear();
+    Complete(std::move(request));
+}
+
+void AsyncIO::ReadBlocking(std::unique_ptr<Request> request) {
+    std::ifstream f { request->filename, std::ios::binary | std::ios::ate };
+
+    if (!f.is_open()) {
+        Fail(std::move(request), "Could not open file");
+        return;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(f.tellg());
+    uint64_t available = request->offset < fileSize ? fileSize - request->offset : 0;
+    std::vector<uint8_t>& data = request->result.data;
+
+    data.resize(static_cast<size_t>(std::min<uint64_t>(request->size, available)));
+    f.seekg(request->offset);
+    f.read(reinterpret_cast<char*>(data.data()), data.size());
+    if (!f) {
+        Fail(std::move(request), "Could not read file");
+        return;
+    }
+    Complete(std::move(request));
+}
+
+#ifdef IO_URING_AVAILABLE
+
+bool AsyncIO::Open(Request& request) {
+    struct stat info;
+
+    request.fd = ::open(request.filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (request.fd < 0) {
+        return false;
+    }
+    if (fstat(request.fd, &info) != 0) {
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(info.st_size);
+    uint64_t available = request.offset < fileSize ? fileSize - request.offset : 0;
+
+    request.size = static_cast<size_t>(std::min<uint64_t>(request.size, available));
+    request.result.data.resize(request.size);
+    return true;
+}
+
+void AsyncIO::QueueRing(Request* request) {
+    std::lock_guard<std::mutex> lock { ringMutex };
+    ringBacklog.push_back(request);
+}
+
+void AsyncIO::FillRing() {
+    // one entry stays free for the shutdown nop, and the completion ring holds
+    // twice the submission entries, so completions can not overflow
+    uint32_t limit = ring->GetEntryCount() - 1;
+
+    while (!ringBacklog.empty() && ringQueued < limit) {
+        Request* request = ringBacklog.front();
+
+        request->vec.iov_base = request->result.data.data() + request->done;
+        request->vec.iov_len = request->size - request->done;
+        if (!ring->PrepareReadv(request->fd, &request->vec, 1, request->offset + request->done, reinterpret_cast<uint64_t>(request))) {
+            break;
+        }
+        ringBacklog.pop_front();
+        ringQueued++;
+    }
+    int result = ring->Submit();
+    if (result < 0) {
+        BLOG_ERROR(IO, "Could not submit to io_uring: %s", std::strerror(-result));
+    }
+}
+
+void AsyncIO::Reap() {
+    bool stopping = false;
+
+    while (!stopping) {
+        std::vector<Request*> retry;
+        uint64_t userData;
+        int32_t result;
+        int waitResult = ring->Wait();
+
+        if (waitResult < 0) {
+            BLOG_ERROR(IO, "Could not wait for io_uring completions: %s", std::strerror(-waitResult));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        while (ring->PopCompletion(userData, result)) {
+            if (userData == wakeUserData) {
+                stopping = true;
+                continue;
+            }
+            std::unique_ptr<Request> request { reinterpret_cast<Request*>(userData) };
+            {
+                std::lock_guard<std::mutex> lock { ringMutex };
+                ringQueued--;
+            }
+
+            if (result == -EINTR || result == -EAGAIN) {
+                retry.push_back(request.release());
+            } else if (result < 0) {
+                Fail(std::move(request), std::strerror(-result));
+            } else if (result == 0) {
+                // the file shrank since it was opened
+                request->result.data.resize(request->done);
+                Complete(std::move(request));
+            } else {
+                request->done += static_cast<size_t>(result);
+                if (request->done < request->size) {
+                    retry.push_back(request.release());
+                } else {
+                    Complete(std::move(request));
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock { ringMutex };
+        ringBacklog.insert(ringBacklog.begin(), retry.begin(), retry.end());
+        FillRing();
+    }
+}
+
+#else
+
+bool AsyncIO::Open(Request&) {
+    errno = ENOSYS;
+    return false;
+}
+
+void AsyncIO::QueueRing(Request*) {
+}
+
+void AsyncIO::FillRing() {
+}
+
+void AsyncIO::Reap() {
+}
+
+#endif
+
+}
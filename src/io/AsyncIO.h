@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+#include "utility/ThreadPool.h"
+#include "IoUring.h"
+#include "IoStats.h"
+
+namespace io {
+
+enum class IoBackend {
+    IO_URING,
+    THREAD_POOL
+};
+
+struct AsyncIOConfig {
+    uint32_t    queueDepth;
+    size_t      workerCount;
+    bool        preferIoUring;
+};
+
+const AsyncIOConfig defaultAsyncIOConfig { 64, 2, true };
+
+const size_t wholeFile = std::numeric_limits<size_t>::max();
+
+struct ReadResult {
+    uint64_t                id;
+    std::string             filename;
+    uint64_t                offset;
+    std::vector<uint8_t>    data;
+    bool                    success;
+    std::string             error;
+};
+
+using ReadCallback = std::function<void(ReadResult& result)>;
+
+// Reads files off the calling thread. Read only queues a request, Submit
+// hands the batch to io_uring if the kernel allows it or to a thread pool
+// otherwise, and Poll runs the callbacks of finished reads on the thread
+// calling it, so results arrive on the engine thread without locking.
+class AsyncIO {
+
+public:
+    explicit                AsyncIO(const AsyncIOConfig& config_ = defaultAsyncIOConfig);
+                            ~AsyncIO();
+
+    // Reads size bytes (or up to the end of the file) at offset, returns the request id
+    uint64_t                Read(const std::string& filename, ReadCallback callback, uint64_t offset = 0, size_t size = wholeFile);
+    void                    Submit();
+    size_t                  Poll();
+    void                    WaitIdle();
+
+    IoBackend               GetBackend() const { return backend; }
+    const char*             GetBackendName() const;
+    size_t                  GetInFlightCount() const { return inFlight.load(std::memory_order_acquire); }
+    IoStatsSnapshot         GetStats() const { return stats.GetSnapshot(); }
+    void                    LogStats() const { stats.Log(); }
+
+private:
+    struct Request {
+        uint64_t                    id;
+        std::string                 filename;
+        uint64_t                    offset;
+        size_t                      size;
+        ReadCallback                callback;
+        int                         fd;
+        size_t                      done;
+        #ifdef IO_URING_AVAILABLE
+        iovec                       vec;
+        #endif
+        std::chrono::steady_clock::time_point   start;
+        ReadResult                  result;
+    };
+
+    AsyncIOConfig               config;
+    IoBackend                   backend;
+    uint64_t                    nextId;
+    std::vector<std::unique_ptr<Request>>   batch;
+    std::atomic<size_t>         inFlight;
+    IoStats                     stats;
+
+    std::mutex                  completedMutex;
+    std::condition_variable     completedSignal;
+    std::vector<std::unique_ptr<Request>>   completed;
+
+    std::unique_ptr<IoUring>    ring;
+    std::mutex                  ringMutex;
+    std::deque<Request*>        ringBacklog;
+    uint32_t                    ringQueued;
+    std::atomic<bool>           reaping;
+    std::thread                 reaper;
+
+    std::unique_ptr<ThreadPool> pool;
+
+    bool                        Open(Request& request);
+    void                        Complete(std::unique_ptr<Request> request);
+    void                        Fail(std::unique_ptr<Request> request, const std::string& error);
+    void                        ReadBlocking(std::unique_ptr<Request> request);
+    void                        QueueRing(Request* request);
+    void                        FillRing();
+    void                        Reap();
+};
+
+}
@@ -0,0 +1,141 @@
+#include "IoStats.h"
+
+namespace io {
+
+Log2Histogram::Log2Histogram() {
+    for (auto& bucket: buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Log2Histogram::Record(uint64_t value) {
+    size_t bucket = 0;
+
+    while (value != 0 && bucket < bucketCount - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Log2Histogram::Reset() {
+    for (auto& bucket: buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::array<uint64_t, Log2Histogram::bucketCount> Log2Histogram::GetCounts() const {
+    std::array<uint64_t, bucketCount> counts;
+
+    for (size_t i = 0; i < bucketCount; i++) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+uint64_t Log2Histogram::GetBucketLimit(size_t bucket) {
+    return bucket == 0 ? 0 : (uint64_t(1) << bucket) - 1;
+}
+
+uint64_t Log2Histogram::GetPercentile(double fraction) const {
+    auto counts = GetCounts();
+    uint64_t total = 0;
+    uint64_t seen = 0;
+
+    for (auto count: counts) {
+        total += count;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    for (size_t i = 0; i < bucketCount; i++) {
+        seen += counts[i];
+        if (seen >= fraction * total) {
+            return GetBucketLimit(i);
+        }
+    }
+    return GetBucketLimit(bucketCount - 1);
+}
+
+IoStats::IoStats():
+    submitted { 0 },
+    completed { 0 },
+    failed { 0 },
+    bytesRead { 0 },
+    queueDepth { 0 },
+    maxQueueDepth { 0 },
+    firstSubmit { 0 } {
+}
+
+void IoStats::RecordSubmit() {
+    uint64_t current = queueDepth.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t peak = maxQueueDepth.load(std::memory_order_relaxed);
+    int64_t unset = 0;
+
+    while (current > peak && !maxQueueDepth.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+    firstSubmit.compare_exchange_strong(unset, Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    submitted.fetch_add(1, std::memory_order_relaxed);
+    depth.Record(current);
+}
+
+void IoStats::RecordComplete(uint64_t bytes, Clock::duration duration, bool success) {
+    queueDepth.fetch_sub(1, std::memory_order_relaxed);
+    completed.fetch_add(1, std::memory_order_relaxed);
+    bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+    if (!success) {
+        failed.fetch_add(1, std::memory_order_relaxed);
+    }
+    latency.Record(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+IoStatsSnapshot IoStats::GetSnapshot() const {
+    IoStatsSnapshot snapshot {};
+    int64_t start = firstSubmit.load(std::memory_order_relaxed);
+
+    snapshot.submitted = submitted.load(std::memory_order_relaxed);
+    snapshot.completed = completed.load(std::memory_order_relaxed);
+    snapshot.failed = failed.load(std::memory_order_relaxed);
+    snapshot.bytesRead = bytesRead.load(std::memory_order_relaxed);
+    snapshot.queueDepth = queueDepth.load(std::memory_order_relaxed);
+    snapshot.maxQueueDepth = maxQueueDepth.load(std::memory_order_relaxed);
+    snapshot.latencyP50 = latency.GetPercentile(0.5);
+    snapshot.latencyP99 = latency.GetPercentile(0.99);
+    snapshot.latencyCounts = latency.GetCounts();
+    snapshot.queueDepthCounts = depth.GetCounts();
+
+    if (start != 0) {
+        double elapsed = std::chrono::duration<double>(Clock::now().time_since_epoch() - Clock::duration(start)).count();
+        snapshot.throughput = elapsed > 0.0 ? snapshot.bytesRead / elapsed : 0.0;
+    }
+    return snapshot;
+}
+
+static void LogHistogram(const char* name, const char* unit, const std::array<uint64_t, Log2Histogram::bucketCount>& counts) {
+    for (size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] != 0) {
+            LOG_DEBUG(IO, FORMAT("%s <= %llu %s: %llu", name,
+                static_cast<unsigned long long>(Log2Histogram::GetBucketLimit(i)), unit,
+                static_cast<unsigned long long>(counts[i])));
+        }
+    }
+}
+
+void IoStats::Log() const {
+    IoStatsSnapshot snapshot { GetSnapshot() };
+
+    LOG_INFO(IO, FORMAT("Reads: %llu submitted, %llu completed, %llu failed, %.2f MiB, %.2f MiB/s",
+        static_cast<unsigned long long>(snapshot.submitted),
+        static_cast<unsigned long long>(snapshot.completed),
+        static_cast<unsigned long long>(snapshot.failed),
+        snapshot.bytesRead / (1024.0 * 1024.0),
+        snapshot.throughput / (1024.0 * 1024.0)));
+    LOG_INFO(IO, FORMAT("Latency p50 <= %llu us, p99 <= %llu us, max queue depth %llu",
+        static_cast<unsigned long long>(snapshot.latencyP50),
+        static_cast<unsigned long long>(snapshot.latencyP99),
+        static_cast<unsigned long long>(snapshot.maxQueueDepth)));
+    LogHistogram("Latency", "us", snapshot.latencyCounts);
+    LogHistogram("Queue depth", "reads", snapshot.queueDepthCounts);
+}
+
+}
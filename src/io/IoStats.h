@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "logging/StdLogger.h"
+#include "utility/Format.h"
+
+namespace io {
+
+// Power of two buckets, bucket i counts values in [2^(i-1), 2^i), bucket 0 counts zeros
+class Log2Histogram {
+
+public:
+    static const size_t     bucketCount = 32;
+
+                            Log2Histogram();
+
+    void                    Record(uint64_t value);
+    void                    Reset();
+    std::array<uint64_t, bucketCount> GetCounts() const;
+
+    // Upper bound of the bucket holding the given fraction of all samples
+    uint64_t                GetPercentile(double fraction) const;
+
+    static uint64_t         GetBucketLimit(size_t bucket);
+
+private:
+    std::atomic<uint64_t>   buckets[bucketCount];
+};
+
+struct IoStatsSnapshot {
+    uint64_t        submitted;
+    uint64_t        completed;
+    uint64_t        failed;
+    uint64_t        bytesRead;
+    uint64_t        queueDepth;
+    uint64_t        maxQueueDepth;
+    double          throughput;
+    uint64_t        latencyP50;
+    uint64_t        latencyP99;
+    std::array<uint64_t, Log2Histogram::bucketCount>    latencyCounts;
+    std::array<uint64_t, Log2Histogram::bucketCount>    queueDepthCounts;
+};
+
+// Counters shared by the submitting thread and the completion side.
+// Latencies are in microseconds, queue depth is sampled on every submission,
+// throughput is bytes per second since the first submission.
+class IoStats {
+
+public:
+                            IoStats();
+
+    void                    RecordSubmit();
+    void                    RecordComplete(uint64_t bytes, std::chrono::steady_clock::duration latency, bool success);
+    IoStatsSnapshot         GetSnapshot() const;
+    void                    Log() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<uint64_t>   submitted;
+    std::atomic<uint64_t>   completed;
+    std::atomic<uint64_t>   failed;
+    std::atomic<uint64_t>   bytesRead;
+    std::atomic<uint64_t>   queueDepth;
+    std::atomic<uint64_t>   maxQueueDepth;
+    std::atomic<int64_t>    firstSubmit;
+    Log2Histogram           latency;
+    Log2Histogram           depth;
+};
+
+}
@@ -0,0 +1,228 @@
+#include "IoUring.h"
+
+#ifdef IO_URING_AVAILABLE
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace io {
+
+#ifdef IO_URING_AVAILABLE
+
+static int SetupRing(uint32_t entries, io_uring_params& params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+static int EnterRing(int fd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static uint32_t* RingField(void* ring, uint32_t offset) {
+    return reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(ring) + offset);
+}
+
+bool IoUring::IsSupported() {
+    io_uring_params params {};
+    int probe = SetupRing(1, params);
+
+    if (probe < 0) {
+        return false;
+    }
+    close(probe);
+    return true;
+}
+
+IoUring::IoUring(uint32_t entries):
+    fd { -1 },
+    sqEntries { 0 },
+    pending { 0 },
+    sqRing { MAP_FAILED },
+    cqRing { MAP_FAILED },
+    sqRingSize { 0 },
+    cqRingSize { 0 },
+    sqesMemory { MAP_FAILED },
+    sqesSize { 0 } {
+
+    io_uring_params params {};
+
+    fd = SetupRing(entries, params);
+    if (fd < 0) {
+        throw std::runtime_error("Could not create io_uring: " + std::string(std::strerror(errno)));
+    }
+    sqEntries = params.sq_entries;
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    // newer kernels share one mapping between both rings
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    }
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sqRing != MAP_FAILED) {
+        cqRing = singleMap ? sqRing :
+            mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    }
+    sqesMemory = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqesMemory == MAP_FAILED) {
+        Release();
+        throw std::runtime_error("Could not map io_uring rings");
+    }
+
+    sqHead = RingField(sqRing, params.sq_off.head);
+    sqTail = RingField(sqRing, params.sq_off.tail);
+    sqMask = *RingField(sqRing, params.sq_off.ring_mask);
+    sqArray = RingField(sqRing, params.sq_off.array);
+    cqHead = RingField(cqRing, params.cq_off.head);
+    cqTail = RingField(cqRing, params.cq_off.tail);
+    cqMask = *RingField(cqRing, params.cq_off.ring_mask);
+    cqes = static_cast<uint8_t*>(cqRing) + params.cq_off.cqes;
+}
+
+IoUring::~IoUring() {
+    Release();
+}
+
+void IoUring::Release() {
+    if (sqesMemory != MAP_FAILED) {
+        munmap(sqesMemory, sqesSize);
+    }
+    if (cqRing != MAP_FAILED && cqRing != sqRing) {
+        munmap(cqRing, cqRingSize);
+    }
+    if (sqRing != MAP_FAILED) {
+        munmap(sqRing, sqRingSize);
+    }
+    sqesMemory = cqRing = sqRing = MAP_FAILED;
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+io_uring_sqe* IoUring::NextSqe() {
+    // only the submitting side writes the tail, the kernel advances the head
+    uint32_t tail = *sqTail;
+    uint32_t head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+
+    if (tail - head >= sqEntries) {
+        return nullptr;
+    }
+    uint32_t index = tail & sqMask;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqesMemory) + index;
+
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    sqArray[index] = index;
+    return sqe;
+}
+
+bool IoUring::PrepareReadv(int file, const iovec* vecs, uint32_t vecCount, uint64_t offset, uint64_t userData) {
+    io_uring_sqe* sqe = NextSqe();
+
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = file;
+    sqe->addr = reinterpret_cast<uint64_t>(vecs);
+    sqe->len = vecCount;
+    sqe->off = offset;
+    sqe->user_data = userData;
+    __atomic_store_n(sqTail, *sqTail + 1, __ATOMIC_RELEASE);
+    pending++;
+    return true;
+}
+
+bool IoUring::PrepareNop(uint64_t userData) {
+    io_uring_sqe* sqe = NextSqe();
+
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_NOP;
+    sqe->user_data = userData;
+    __atomic_store_n(sqTail, *sqTail + 1, __ATOMIC_RELEASE);
+    pending++;
+    return true;
+}
+
+int IoUring::Submit() {
+    int result;
+
+    if (pending == 0) {
+        return 0;
+    }
+    do {
+        result = EnterRing(fd, pending, 0, 0);
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0) {
+        return -errno;
+    }
+    pending -= std::min<uint32_t>(pending, static_cast<uint32_t>(result));
+    return result;
+}
+
+int IoUring::Wait() {
+    int result;
+
+    do {
+        result = EnterRing(fd, 0, 1, IORING_ENTER_GETEVENTS);
+    } while (result < 0 && errno == EINTR);
+
+    return result < 0 ? -errno : result;
+}
+
+bool IoUring::PopCompletion(uint64_t& userData, int32_t& result) {
+    uint32_t head = *cqHead;
+
+    if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    const io_uring_cqe& cqe = static_cast<const io_uring_cqe*>(cqes)[head & cqMask];
+
+    userData = cqe.user_data;
+    result = cqe.res;
+    __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+#else
+
+bool IoUring::IsSupported() {
+    return false;
+}
+
+IoUring::IoUring(uint32_t):
+    fd { -1 },
+    sqEntries { 0 },
+    pending { 0 } {
+    throw std::runtime_error("Could not create io_uring, not supported on this platform");
+}
+
+IoUring::~IoUring() {
+}
+
+void IoUring::Release() {
+}
+
+int IoUring::Submit() {
+    return -1;
+}
+
+int IoUring::Wait() {
+    return -1;
+}
+
+bool IoUring::PopCompletion(uint64_t&, int32_t&) {
+    return false;
+}
+
+#endif
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define IO_URING_AVAILABLE 1
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+#endif
+#endif
+
+namespace io {
+
+// Minimal io_uring wrapper on the raw syscalls, so there is no liburing
+// dependency. One thread may prepare and submit while another reaps
+// completions, more than one submitter needs external locking.
+class IoUring {
+
+public:
+    // False if the kernel lacks io_uring or it is blocked, e.g. by seccomp in containers
+    static bool             IsSupported();
+
+    explicit                IoUring(uint32_t entries);
+                            IoUring(const IoUring& other) = delete;
+                            ~IoUring();
+
+    IoUring&                operator=(const IoUring& other) = delete;
+
+    #ifdef IO_URING_AVAILABLE
+    // Both return false if the submission queue is full
+    bool                    PrepareReadv(int fd, const iovec* vecs, uint32_t vecCount, uint64_t offset, uint64_t userData);
+    bool                    PrepareNop(uint64_t userData);
+    #endif
+
+    // Submit hands everything prepared to the kernel and belongs to the submitting
+    // thread, Wait blocks until a completion is available and belongs to the reaper.
+    // Both return a negative errno on failure.
+    int                     Submit();
+    int                     Wait();
+    bool                    PopCompletion(uint64_t& userData, int32_t& result);
+    uint32_t                GetEntryCount() const { return sqEntries; }
+
+private:
+    int                     fd;
+    uint32_t                sqEntries;
+    uint32_t                pending;
+    void*                   sqRing;
+    void*                   cqRing;
+    size_t                  sqRingSize;
+    size_t                  cqRingSize;
+    void*                   sqesMemory;
+    size_t                  sqesSize;
+    uint32_t*               sqHead;
+    uint32_t*               sqTail;
+    uint32_t                sqMask;
+    uint32_t*               sqArray;
+    uint32_t*               cqHead;
+    uint32_t*               cqTail;
+    uint32_t                cqMask;
+    void*                   cqes;
+
+    void                    Release();
+    #ifdef IO_URING_AVAILABLE
+    io_uring_sqe*           NextSqe();
+    #endif
+};
+
+}
@@ -0,0 +1,299 @@
+#include "AsyncLogger.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace logging {
+
+const size_t AsyncLogger::maxMessageLength;
+
+static std::atomic<AsyncLogger*> crashLogger { nullptr };
+static std::terminate_handler previousTerminate { nullptr };
+
+static size_t RoundUpPow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+AsyncLogger::AsyncLogger(LogLevel logLevel_, std::ostream& outStream_, size_t capacity_, OverflowPolicy policy_):
+    Logger(logLevel_, outStream_),
+    ring(RoundUpPow2(std::max<size_t>(capacity_, 2))),
+    mask { ring.size() - 1 },
+    policy { policy_ },
+    enqueuePos { 0 },
+    writtenCount { 0 },
+    dropped { 0 },
+    reportedDrops { 0 },
+    running { true },
+    sleeping { false },
+    consuming ATOMIC_FLAG_INIT,
+    dequeuePos { 0 },
+    cachedTime { 0 },
+    cachedPrefix { } {
+
+    for (size_t i = 0; i < ring.size(); i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    batch.reserve(ring.size() * 64);
+    worker = std::thread(&AsyncLogger::Run, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    AsyncLogger* self = this;
+    crashLogger.compare_exchange_strong(self, nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock { wakeMutex };
+        running.store(false, std::memory_order_release);
+        wake.notify_all();
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void AsyncLogger::Submit(LogLevel level, const std::string& msg) {
+    time_t timestamp = time(nullptr);
+
+    while (!TryPush(level, timestamp, msg)) {
+        if (policy == OverflowPolicy::DROP) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Notify();
+        std::this_thread::yield();
+    }
+    Notify();
+}
+
+// Reserved but not yet published records count as queued, the worker finds them a moment later
+bool AsyncLogger::HasQueued() const {
+    return enqueuePos.load(std::memory_order_relaxed) != writtenCount.load(std::memory_order_relaxed);
+}
+
+// Submit checks the sleeping flag after queueing and the worker checks the ring after
+// raising it, both behind a sequentially consistent fence, so one of them sees the other
+void AsyncLogger::Sleep() {
+    std::unique_lock<std::mutex> lock { wakeMutex };
+
+    sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wake.wait(lock, [this]() { return !running.load(std::memory_order_acquire) || HasQueued(); });
+    sleeping.store(false, std::memory_order_relaxed);
+}
+
+void AsyncLogger::Notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock { wakeMutex };
+        wake.notify_one();
+    }
+}
+
+bool AsyncLogger::TryPush(LogLevel level, time_t timestamp, const std::string& msg) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Record* record;
+
+    for (;;) {
+        record = &ring[pos & mask];
+        size_t seq = record->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->level = level;
+    record->timestamp = timestamp;
+    record->length = static_cast<uint32_t>(std::min(msg.size(), maxMessageLength));
+    std::memcpy(record->text, msg.data(), record->length);
+    record->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void AsyncLogger::Flush() {
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+
+    while (writtenCount.load(std::memory_order_acquire) < target) {
+        if (!running.load(std::memory_order_acquire)) {
+            break;
+        }
+        std::this_thread::yield();
+    }
+}
+
+size_t AsyncLogger::Drain() {
+    size_t count = 0;
+
+    batch.clear();
+    for (;;) {
+        Record& record = ring[dequeuePos & mask];
+        size_t seq = record.sequence.load(std::memory_order_acquire);
+
+        if (seq != dequeuePos + 1) {
+            break;
+        }
+        FormatRecord(record);
+        record.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        dequeuePos++;
+        count++;
+    }
+
+    uint64_t drops = dropped.load(std::memory_order_relaxed);
+    if (drops != reportedDrops) {
+        Record note {};
+
+        note.level = LogLevel::WARN;
+        note.timestamp = time(nullptr);
+        note.length = snprintf(note.text, maxMessageLength, "Async logger dropped %llu messages",
+            static_cast<unsigned long long>(drops - reportedDrops));
+        FormatRecord(note);
+        reportedDrops = drops;
+    }
+
+    if (!batch.empty()) {
+        outStream.write(batch.data(), batch.size());
+        outStream.flush();
+    }
+    writtenCount.fetch_add(count, std::memory_order_release);
+    return count;
+}
+
+void AsyncLogger::FormatRecord(const Record& record) {
+    if (record.timestamp != cachedTime) {
+        struct tm localTime;
+
+        #ifdef _WIN32
+        localtime_s(&localTime, &record.timestamp);
+        #endif
+        #ifdef __linux__
+        localtime_r(&record.timestamp, &localTime);
+        #endif
+
+        snprintf(cachedPrefix, sizeof(cachedPrefix), "[%04d-%02d-%02d %02d:%02d:%02d] ",
+            localTime.tm_year + 1900,
+            localTime.tm_mon + 1,
+            localTime.tm_mday,
+            localTime.tm_hour,
+            localTime.tm_min,
+            localTime.tm_sec);
+        cachedTime = record.timestamp;
+    }
+
+    batch.append(cachedPrefix);
+    batch.append(GetLevelName(record.level));
+    batch.append(" - ");
+    batch.append(record.text, record.length);
+    batch.push_back('\n');
+}
+
+void AsyncLogger::Run() {
+    while (running.load(std::memory_order_acquire)) {
+        size_t count = 0;
+
+        if (!consuming.test_and_set(std::memory_order_acquire)) {
+            count = Drain();
+            consuming.clear(std::memory_order_release);
+        }
+        if (count > 0) {
+            continue;
+        }
+        if (HasQueued()) {
+            // a producer is between reserving and publishing, or DrainNow holds the ring
+            std::this_thread::yield();
+        } else {
+            Sleep();
+        }
+    }
+
+    while (consuming.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    while (Drain() > 0) {
+    }
+    consuming.clear(std::memory_order_release);
+}
+
+static void DrainOnCrash() {
+    AsyncLogger* logger = crashLogger.exchange(nullptr);
+
+    if (logger != nullptr) {
+        logger->DrainNow();
+    }
+}
+
+static void CrashSignalHandler(int sig) {
+    AsyncLogger* logger = crashLogger.exchange(nullptr);
+
+    if (logger != nullptr) {
+        logger->WriteQueuedUnformatted(2);
+    }
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+static void CrashTerminateHandler() {
+    DrainOnCrash();
+    if (previousTerminate != nullptr) {
+        previousTerminate();
+    }
+    std::abort();
+}
+
+void AsyncLogger::InstallCrashHandler(AsyncLogger* logger) {
+    crashLogger.store(logger);
+    previousTerminate = std::set_terminate(CrashTerminateHandler);
+
+    for (int sig: { SIGSEGV, SIGABRT, SIGFPE, SIGILL }) {
+        std::signal(sig, CrashSignalHandler);
+    }
+}
+
+// Nothing but lock-free atomics and write(2), records keep their level but lose the timestamp
+void AsyncLogger::WriteQueuedUnformatted(int fd) {
+    #ifdef __linux__
+    if (consuming.test_and_set(std::memory_order_acquire)) {
+        return;
+    }
+    for (size_t pos = dequeuePos;; pos++) {
+        const Record& record = ring[pos & mask];
+
+        if (record.sequence.load(std::memory_order_acquire) != pos + 1) {
+            break;
+        }
+        const char* level = GetLevelName(record.level);
+        ssize_t ignored = write(fd, level, std::strlen(level));
+        ignored = write(fd, " - ", 3);
+        ignored = write(fd, record.text, record.length);
+        ignored = write(fd, "\n", 1);
+        (void) ignored;
+    }
+    #else
+    (void) fd;
+    #endif
+}
+
+// Best effort: if the crash happened inside the worker while it held the ring, give up
+void AsyncLogger::DrainNow() {
+    for (int attempt = 0; attempt < 1000; attempt++) {
+        if (!consuming.test_and_set(std::memory_order_acquire)) {
+            while (Drain() > 0) {
+            }
+            consuming.clear(std::memory_order_release);
+            return;
+        }
+    }
+}
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <exception>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <csignal>
+#include <ctime>
+
+#include "Logger.h"
+
+namespace logging {
+
+enum class OverflowPolicy {
+    DROP,
+    BLOCK
+};
+
+// Logger which only copies the message into a bounded lock-free MPSC ring on
+// the calling thread. A background thread formats the records, reusing the
+// timestamp prefix while the second does not change, and writes them in batches.
+// It sleeps while the ring is empty and is woken by the next Submit.
+class AsyncLogger: public Logger {
+
+public:
+    static const size_t     maxMessageLength = 480;
+
+                            AsyncLogger(LogLevel logLevel_,
+                                std::ostream& outStream_,
+                                size_t capacity_,
+                                OverflowPolicy policy_);
+                            ~AsyncLogger();
+
+    void                    Flush() override;
+    void                    DrainNow();
+    uint64_t                GetDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Drains whatever is still queued on std::terminate. A fatal signal only writes the
+    // queued messages unformatted to stderr, formatting is not async-signal-safe.
+    static void             InstallCrashHandler(AsyncLogger* logger);
+    // Async-signal-safe, gives up if another thread is draining the ring
+    void                    WriteQueuedUnformatted(int fd);
+
+private:
+    struct Record {
+        std::atomic<size_t>     sequence;
+        LogLevel                level;
+        time_t                  timestamp;
+        uint32_t                length;
+        char                    text[maxMessageLength];
+    };
+
+    std::vector<Record>     ring;
+    size_t                  mask;
+    OverflowPolicy          policy;
+    std::atomic<size_t>     enqueuePos;
+    std::atomic<size_t>     writtenCount;
+    std::atomic<uint64_t>   dropped;
+    uint64_t                reportedDrops;
+    std::atomic<bool>       running;
+    std::atomic<bool>       sleeping;
+    std::mutex              wakeMutex;
+    std::condition_variable wake;
+    std::atomic_flag        consuming;
+    size_t                  dequeuePos;
+    time_t                  cachedTime;
+    char                    cachedPrefix[80];   // fits every field at full int width
+    std::string             batch;
+    std::thread             worker;
+
+    void                    Submit(LogLevel level, const std::string& msg) override;
+    bool                    TryPush(LogLevel level, time_t timestamp, const std::string& msg);
+    bool                    HasQueued() const;
+    void                    Sleep();
+    void                    Notify();
+    size_t                  Drain();
+    void                    FormatRecord(const Record& record);
+    void                    Run();
+};
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+// On-disk layout shared by BinaryLogger and the logdecode tool.
+// A file is a BinaryLogHeader followed by 8 byte aligned records. A record
+// size of 0 marks the end, which also covers files cut short by a crash.
+
+namespace logging {
+
+const char binaryLogMagic[8] = { 'T', 'V', 'B', 'L', 'O', 'G', '1', '\0' };
+const uint32_t binaryLogVersion = 2;
+const uint32_t binaryRecordAlignment = 8;
+
+struct BinaryLogHeader {
+    char            magic[8];
+    uint32_t        version;
+    uint32_t        headerSize;
+    int64_t         tickNum;        // steady_clock period as a ratio of seconds
+    int64_t         tickDen;
+    int64_t         startTicks;
+    int64_t         startWallNs;    // system_clock time at startTicks, ns since epoch
+};
+
+enum class BinaryRecordType: uint16_t {
+    FORMAT = 1,
+    MESSAGE = 2
+};
+
+struct BinaryRecordHeader {
+    uint32_t        size;           // whole record including padding, written last
+    uint16_t        type;
+    uint16_t        level;
+};
+
+// Followed by fileLength bytes of file name and formatLength bytes of format string
+struct BinaryFormatRecord {
+    BinaryRecordHeader  header;
+    uint32_t            formatId;
+    uint32_t            line;
+    uint32_t            fileLength;
+    uint32_t            formatLength;
+};
+
+// Followed by argSize bytes of tagged arguments
+struct BinaryMessageRecord {
+    BinaryRecordHeader  header;
+    uint32_t            formatId;
+    uint32_t            argSize;
+    int64_t             ticks;
+};
+
+// Every argument starts with a tag byte. Integers, floats and pointers follow as
+// 8 bytes, strings as a uint32_t length and the raw characters. Signed integers
+// promoting to int are tagged SIGNED32, so %x prints them at their own width.
+enum class BinaryArgTag: uint8_t {
+    SIGNED = 'i',
+    SIGNED32 = 'I',
+    UNSIGNED = 'u',
+    BOOL = 'b',
+    FLOAT = 'f',
+    STRING = 's',
+    POINTER = 'p'
+};
+
+}
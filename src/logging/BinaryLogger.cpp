@@ -0,0 +1,146 @@
+#include "BinaryLogger.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace logging {
+
+// file space is committed in steps so the mapping can be reserved up front
+static const size_t growStep = 4 * 1024 * 1024;
+
+BinaryLogger::BinaryLogger(LogLevel logLevel_, const std::string& filename, size_t maxSize):
+    Logger(logLevel_),
+    fd { -1 },
+    mapped { nullptr },
+    capacity { maxSize },
+    writePos { sizeof(BinaryLogHeader) },
+    fileSize { 0 },
+    nextFormatId { 0 },
+    dropped { 0 },
+    stringFormatIds { } {
+
+    #ifdef __linux__
+    fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open binary log " + filename);
+    }
+    void* data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Could not map binary log " + filename);
+    }
+    mapped = static_cast<uint8_t*>(data);
+    Grow(writePos.load());
+    #else
+    throw std::runtime_error("Binary logging needs mmap support");
+    #endif
+
+    BinaryLogHeader header {};
+    std::memcpy(header.magic, binaryLogMagic, sizeof(header.magic));
+    header.version = binaryLogVersion;
+    header.headerSize = sizeof(BinaryLogHeader);
+    header.tickNum = std::chrono::steady_clock::period::num;
+    header.tickDen = std::chrono::steady_clock::period::den;
+    header.startTicks = std::chrono::steady_clock::now().time_since_epoch().count();
+    header.startWallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::memcpy(mapped, &header, sizeof(header));
+
+    for (int level = 0; level < 4; level++) {
+        stringFormatIds[level] = RegisterFormat(static_cast<LogLevel>(level), "%s", "", 0);
+    }
+}
+
+BinaryLogger::~BinaryLogger() {
+    #ifdef __linux__
+    size_t used = std::min(writePos.load(), capacity);
+
+    msync(mapped, used, MS_SYNC);
+    munmap(mapped, capacity);
+    if (ftruncate(fd, used) != 0) {
+        std::cerr << "Could not truncate binary log" << std::endl;
+    }
+    close(fd);
+    #endif
+}
+
+uint32_t BinaryLogger::RegisterFormat(LogLevel level, const char* format, const char* file, int line) {
+    uint32_t id = nextFormatId.fetch_add(1, std::memory_order_relaxed);
+    uint32_t fileLength = static_cast<uint32_t>(std::strlen(file));
+    uint32_t formatLength = static_cast<uint32_t>(std::strlen(format));
+    size_t size = (sizeof(BinaryFormatRecord) + fileLength + formatLength + binaryRecordAlignment - 1) & ~size_t(binaryRecordAlignment - 1);
+    uint8_t* record = Reserve(size);
+
+    if (record != nullptr) {
+        BinaryFormatRecord formatRecord {};
+        formatRecord.formatId = id;
+        formatRecord.line = static_cast<uint32_t>(line);
+        formatRecord.fileLength = fileLength;
+        formatRecord.formatLength = formatLength;
+
+        std::memcpy(record, &formatRecord, sizeof(formatRecord));
+        std::memcpy(record + sizeof(formatRecord), file, fileLength);
+        std::memcpy(record + sizeof(formatRecord) + fileLength, format, formatLength);
+        Commit(record, size, BinaryRecordType::FORMAT, level);
+    }
+    return id;
+}
+
+void BinaryLogger::Flush() {
+    #ifdef __linux__
+    msync(mapped, std::min(writePos.load(), capacity), MS_ASYNC);
+    #endif
+}
+
+void BinaryLogger::Submit(LogLevel level, const std::string& msg) {
+    WriteRecord(level, stringFormatIds[static_cast<int>(level)], msg);
+}
+
+uint8_t* BinaryLogger::Reserve(size_t size) {
+    size_t offset = writePos.fetch_add(size, std::memory_order_relaxed);
+
+    // leave room for the zero size end marker
+    if (offset + size + sizeof(BinaryRecordHeader) > capacity) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    if (offset + size + sizeof(BinaryRecordHeader) > fileSize.load(std::memory_order_acquire)) {
+        Grow(offset + size + sizeof(BinaryRecordHeader));
+    }
+    return mapped + offset;
+}
+
+void BinaryLogger::Commit(uint8_t* record, size_t size, BinaryRecordType type, LogLevel level) {
+    BinaryRecordHeader header {};
+
+    header.type = static_cast<uint16_t>(type);
+    header.level = static_cast<uint16_t>(level);
+    std::memcpy(record + offsetof(BinaryRecordHeader, type), &header.type, sizeof(header.type) + sizeof(header.level));
+
+    // the size goes in last so a reader never sees a record before its payload
+    reinterpret_cast<std::atomic<uint32_t>*>(record)->store(static_cast<uint32_t>(size), std::memory_order_release);
+}
+
+void BinaryLogger::Grow(size_t required) {
+    std::lock_guard<std::mutex> lock(growMutex);
+    size_t size = fileSize.load(std::memory_order_relaxed);
+
+    if (size >= required) {
+        return;
+    }
+    while (size < required) {
+        size += growStep;
+    }
+    size = std::min(size, capacity);
+    #ifdef __linux__
+    if (ftruncate(fd, size) != 0) {
+        throw std::runtime_error("Could not grow binary log");
+    }
+    #endif
+    fileSize.store(size, std::memory_order_release);
+}
+
+}
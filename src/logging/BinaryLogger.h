@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+
+#include "Logger.h"
+#include "BinaryLogFormat.h"
+
+namespace logging {
+
+inline size_t GetBinaryArgSize(const std::string& str) { return 1 + sizeof(uint32_t) + str.size(); }
+inline size_t GetBinaryArgSize(const char* str) { return 1 + sizeof(uint32_t) + (str != nullptr ? std::strlen(str) : 0); }
+inline size_t GetBinaryArgSize(const void*) { return 1 + sizeof(uint64_t); }
+inline size_t GetBinaryArgSize(double) { return 1 + sizeof(double); }
+template<typename T>
+std::enable_if_t<std::is_integral<T>::value, size_t> GetBinaryArgSize(T) { return 1 + sizeof(uint64_t); }
+
+template<typename T>
+void WriteBinaryValue(uint8_t*& out, BinaryArgTag tag, const T& value) {
+    *out++ = static_cast<uint8_t>(tag);
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+inline void WriteBinaryString(uint8_t*& out, const char* str, uint32_t length) {
+    *out++ = static_cast<uint8_t>(BinaryArgTag::STRING);
+    std::memcpy(out, &length, sizeof(length));
+    out += sizeof(length);
+    std::memcpy(out, str, length);
+    out += length;
+}
+
+inline void EncodeBinaryArg(uint8_t*& out, const std::string& str) {
+    WriteBinaryString(out, str.data(), static_cast<uint32_t>(str.size()));
+}
+
+inline void EncodeBinaryArg(uint8_t*& out, const char* str) {
+    WriteBinaryString(out, str, str != nullptr ? static_cast<uint32_t>(std::strlen(str)) : 0);
+}
+
+inline void EncodeBinaryArg(uint8_t*& out, const void* ptr) {
+    WriteBinaryValue(out, BinaryArgTag::POINTER, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)));
+}
+
+inline void EncodeBinaryArg(uint8_t*& out, double value) {
+    WriteBinaryValue(out, BinaryArgTag::FLOAT, value);
+}
+
+template<typename T>
+std::enable_if_t<std::is_integral<T>::value> EncodeBinaryArg(uint8_t*& out, T value) {
+    if (std::is_same<T, bool>::value) {
+        WriteBinaryValue(out, BinaryArgTag::BOOL, static_cast<uint64_t>(value));
+    } else if (std::is_signed<T>::value) {
+        WriteBinaryValue(out, sizeof(+value) <= sizeof(int32_t) ? BinaryArgTag::SIGNED32 : BinaryArgTag::SIGNED, static_cast<int64_t>(value));
+    } else {
+        WriteBinaryValue(out, BinaryArgTag::UNSIGNED, static_cast<uint64_t>(value));
+    }
+}
+
+// Logger appending binary records to a memory mapped file. Call sites register
+// their format string once (see BLOG_* in StdLogger.h) and afterwards only copy
+// the format id, a steady_clock timestamp and the raw arguments. Text is produced
+// offline by the logdecode tool. Messages from the plain Debug/Info/... methods
+// are stored as a single string argument.
+class BinaryLogger: public Logger {
+
+public:
+                            BinaryLogger(LogLevel logLevel_, const std::string& filename, size_t maxSize);
+                            ~BinaryLogger();
+
+    bool                    IsEnabled(LogLevel level) const { return level >= logLevel; }
+    uint32_t                RegisterFormat(LogLevel level, const char* format, const char* file, int line);
+    void                    Flush() override;
+    uint64_t                GetDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    template<typename... Args>
+    void                    WriteRecord(LogLevel level, uint32_t formatId, const Args&... args);
+
+private:
+    int                     fd;
+    uint8_t*                mapped;
+    size_t                  capacity;
+    std::atomic<size_t>     writePos;
+    std::atomic<size_t>     fileSize;
+    std::mutex              growMutex;
+    std::atomic<uint32_t>   nextFormatId;
+    std::atomic<uint64_t>   dropped;
+    uint32_t                stringFormatIds[4];
+
+    void                    Submit(LogLevel level, const std::string& msg) override;
+    uint8_t*                Reserve(size_t size);
+    void                    Commit(uint8_t* record, size_t size, BinaryRecordType type, LogLevel level);
+    void                    Grow(size_t required);
+};
+
+inline size_t SumBinaryArgSizes() {
+    return 0;
+}
+
+template<typename T, typename... Rest>
+size_t SumBinaryArgSizes(const T& first, const Rest&... rest) {
+    return GetBinaryArgSize(first) + SumBinaryArgSizes(rest...);
+}
+
+inline void EncodeBinaryArgs(uint8_t*&) {
+}
+
+template<typename T, typename... Rest>
+void EncodeBinaryArgs(uint8_t*& out, const T& first, const Rest&... rest) {
+    EncodeBinaryArg(out, first);
+    EncodeBinaryArgs(out, rest...);
+}
+
+template<typename... Args>
+void BinaryLogger::WriteRecord(LogLevel level, uint32_t formatId, const Args&... args) {
+    size_t argSize = SumBinaryArgSizes(args...);
+    size_t size = (sizeof(BinaryMessageRecord) + argSize + binaryRecordAlignment - 1) & ~size_t(binaryRecordAlignment - 1);
+    uint8_t* record = Reserve(size);
+
+    if (record == nullptr) {
+        return;
+    }
+    BinaryMessageRecord message {};
+    message.formatId = formatId;
+    message.argSize = static_cast<uint32_t>(argSize);
+    message.ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::memcpy(record, &message, sizeof(message));
+
+    uint8_t* out = record + sizeof(message);
+    EncodeBinaryArgs(out, args...);
+    Commit(record, size, BinaryRecordType::MESSAGE, level);
+}
+
+}
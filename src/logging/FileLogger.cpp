@@ -2,17 +2,92 @@
 
 namespace logging {
 
-FileLogger::FileLogger(LogLevel logLevel_, const std::string& filename):
-    Logger(logLevel_),
-    file { filename } {
+FileLogger::FileLogger(LogLevel logLevel_, const std::string& filename_):
+    FileLogger(logLevel_, filename_, defaultFileLoggerConfig) {
+}
+
+FileLogger::FileLogger(LogLevel logLevel_, const std::string& filename_, const FileLoggerConfig& config_):
+    Logger(logLevel_, file),
+    filename { filename_ },
+    config { config_ },
+    buffer(config_.bufferSize),
+    fileSize { 0 } {
+    Open();
 }
 
 FileLogger::~FileLogger() {
     file.close();
 }
 
+void FileLogger::Submit(LogLevel level, const std::string& msg) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Log(CreateLogMessage(GetLevelName(level), msg));
+    if (level >= LogLevel::ERROR) {
+        outStream.flush();
+        lastFlush = std::chrono::steady_clock::now();
+    }
+}
+
 void FileLogger::Log(const std::string& msg) {
-    file << msg << std::endl;
+    auto now = std::chrono::steady_clock::now();
+
+    if (NeedsRotation(now)) {
+        Rotate();
+    }
+    outStream << msg << '\n';
+    fileSize += msg.size() + 1;
+
+    if (now - lastFlush >= config.flushInterval) {
+        outStream.flush();
+        lastFlush = now;
+    }
+}
+
+void FileLogger::Flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    outStream.flush();
+    lastFlush = std::chrono::steady_clock::now();
+}
+
+void FileLogger::Open() {
+    // the buffer has to be installed before the file is opened to take effect
+    if (!buffer.empty()) {
+        file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    }
+    file.open(filename, std::ios::out | std::ios::app);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open log file " + filename);
+    }
+    file.seekp(0, std::ios::end);
+    fileSize = static_cast<size_t>(file.tellp());
+    openTime = std::chrono::steady_clock::now();
+    lastFlush = openTime;
+}
+
+bool FileLogger::NeedsRotation(std::chrono::steady_clock::time_point now) const {
+    if (config.maxFileSize > 0 && fileSize >= config.maxFileSize) {
+        return true;
+    }
+    return config.maxFileAge.count() > 0 && now - openTime >= config.maxFileAge;
+}
+
+void FileLogger::Rotate() {
+    file.close();
+
+    if (config.maxFiles == 0) {
+        std::remove(filename.c_str());
+    } else {
+        std::remove((filename + "." + std::to_string(config.maxFiles)).c_str());
+        for (unsigned i = config.maxFiles - 1; i > 0; i--) {
+            std::rename((filename + "." + std::to_string(i)).c_str(),
+                (filename + "." + std::to_string(i + 1)).c_str());
+        }
+        std::rename(filename.c_str(), (filename + ".1").c_str());
+    }
+    file.clear();
+    Open();
 }
 
 }
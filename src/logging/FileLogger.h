@@ -2,20 +2,59 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <stdexcept>
 
 #include "Logger.h"
 
 namespace logging {
 
+struct FileLoggerConfig {
+    size_t                      bufferSize;
+    std::chrono::milliseconds   flushInterval;
+    size_t                      maxFileSize;        // rotate once the file reaches this size, 0 disables
+    std::chrono::seconds        maxFileAge;         // rotate once the file is this old, 0 disables
+    unsigned                    maxFiles;           // rotated files kept next to the current one
+};
+
+const FileLoggerConfig defaultFileLoggerConfig {
+    1024 * 1024,
+    std::chrono::milliseconds(1000),
+    64 * 1024 * 1024,
+    std::chrono::seconds(24 * 60 * 60),
+    5
+};
+
+// Writes through a large stream buffer and only flushes every flushInterval,
+// on ERROR messages or on Flush. Rotation renames file to file.1, file.1 to
+// file.2 and so on, dropping everything past maxFiles.
 class FileLogger: public Logger {
 
 	std::ofstream       file;
-
+	std::string         filename;
+	FileLoggerConfig    config;
+	std::vector<char>   buffer;
+	std::mutex          mutex;
+	size_t              fileSize;
+	std::chrono::steady_clock::time_point   openTime;
+	std::chrono::steady_clock::time_point   lastFlush;
+
+	void                Submit(LogLevel level, const std::string& msg) override;
 	void 				Log(const std::string& msg) override;
+	void                Open();
+	void                Rotate();
+	bool                NeedsRotation(std::chrono::steady_clock::time_point now) const;
 
 public:
-                        FileLogger(LogLevel logLevel_, const std::string& filename);
+                        FileLogger(LogLevel logLevel_, const std::string& filename_);
+                        FileLogger(LogLevel logLevel_, const std::string& filename_, const FileLoggerConfig& config_);
 						~FileLogger();
+
+	void                Flush() override;
 };
 
 }
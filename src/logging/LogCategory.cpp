@@ -0,0 +1,130 @@
+#include "LogCategory.h"
+
+namespace logging {
+
+std::atomic<int> categoryLevels[logCategoryCount] = {
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) },
+    { static_cast<int>(defaultLogLevel) }
+};
+
+static const char* const categoryNames[logCategoryCount] = {
+    "general",
+    "vulkan",
+    "validation",
+    "device",
+    "swapchain",
+    "pipeline",
+    "descriptors",
+    "memory",
+    "glfw",
+    "io",
+    "textures"
+};
+
+static std::string ToLower(std::string str) {
+    for (auto& c: str) {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+    return str;
+}
+
+static std::string Trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t");
+    size_t last = str.find_last_not_of(" \t");
+
+    return first == std::string::npos ? std::string() : str.substr(first, last - first + 1);
+}
+
+const char* GetCategoryName(LogCategory category) {
+    size_t index = static_cast<size_t>(category);
+    return index < logCategoryCount ? categoryNames[index] : "unknown";
+}
+
+bool FindCategory(const std::string& name, LogCategory& category) {
+    std::string lower = ToLower(name);
+
+    for (size_t i = 0; i < logCategoryCount; i++) {
+        if (lower == categoryNames[i]) {
+            category = static_cast<LogCategory>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FindLevel(const std::string& name, LogLevel& level) {
+    std::string lower = ToLower(name);
+
+    for (auto candidate: { LogLevel::DEBUG, LogLevel::INFO, LogLevel::WARN, LogLevel::ERROR }) {
+        if (lower == ToLower(GetLevelName(candidate))) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SetLogLevel(LogCategory category, LogLevel level) {
+    categoryLevels[static_cast<size_t>(category)].store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void SetAllLogLevels(LogLevel level) {
+    for (size_t i = 0; i < logCategoryCount; i++) {
+        SetLogLevel(static_cast<LogCategory>(i), level);
+    }
+}
+
+LogLevel GetLogLevel(LogCategory category) {
+    return static_cast<LogLevel>(categoryLevels[static_cast<size_t>(category)].load(std::memory_order_relaxed));
+}
+
+bool ConfigureLogLevels(const std::string& config) {
+    bool valid = true;
+    size_t start = 0;
+
+    while (start <= config.size()) {
+        size_t end = config.find(',', start);
+        std::string entry = Trim(config.substr(start, end == std::string::npos ? std::string::npos : end - start));
+        size_t separator = entry.find('=');
+
+        if (!entry.empty()) {
+            LogCategory category;
+            LogLevel level;
+            std::string name = Trim(entry.substr(0, separator));
+
+            if (separator == std::string::npos || !FindLevel(Trim(entry.substr(separator + 1)), level)) {
+                valid = false;
+            } else if (name == "*") {
+                SetAllLogLevels(level);
+            } else if (FindCategory(name, category)) {
+                SetLogLevel(category, level);
+            } else {
+                valid = false;
+            }
+        }
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    return valid;
+}
+
+void LoadLogLevelsFromEnvironment() {
+    const char* config = std::getenv(logLevelsEnvVar);
+
+    if (config != nullptr && !ConfigureLogLevels(config)) {
+        std::cerr << "Ignored invalid entries in " << logLevelsEnvVar << "=" << config << std::endl;
+    }
+}
+
+}
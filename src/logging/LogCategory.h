@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstdlib>
+#include <cstddef>
+#include <cctype>
+
+#include "Logger.h"
+
+namespace logging {
+
+enum class LogCategory {
+    GENERAL,
+    VULKAN,
+    VALIDATION,
+    DEVICE,
+    SWAPCHAIN,
+    PIPELINE,
+    DESCRIPTORS,
+    MEMORY,
+    GLFW,
+    IO,
+    TEXTURES,
+    COUNT
+};
+
+const size_t logCategoryCount = static_cast<size_t>(LogCategory::COUNT);
+
+// Levels every category starts with, and the variable that overrides them at
+// startup, e.g. TV_LOG_LEVELS="vulkan=debug,glfw=warn" or "*=debug".
+const LogLevel defaultLogLevel = LogLevel::INFO;
+const char* const logLevelsEnvVar = "TV_LOG_LEVELS";
+
+// One slot per category, constant initialized so it is usable during static init
+extern std::atomic<int> categoryLevels[logCategoryCount];
+
+// The only check on the disabled path, one relaxed load
+inline bool IsLogEnabled(LogCategory category, LogLevel level) {
+    return static_cast<int>(level) >= categoryLevels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+const char*         GetCategoryName(LogCategory category);
+bool                FindCategory(const std::string& name, LogCategory& category);
+bool                FindLevel(const std::string& name, LogLevel& level);
+void                SetLogLevel(LogCategory category, LogLevel level);
+void                SetAllLogLevels(LogLevel level);
+LogLevel            GetLogLevel(LogCategory category);
+
+// Applies a "category=level,..." list, "*" addresses every category. Returns false if an entry was not understood.
+bool                ConfigureLogLevels(const std::string& config);
+void                LoadLogLevelsFromEnvironment();
+
+}
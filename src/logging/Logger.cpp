@@ -2,6 +2,16 @@
 
 namespace logging {
 
+const char* GetLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG:   return "DEBUG";
+        case LogLevel::INFO:    return "INFO";
+        case LogLevel::WARN:    return "WARN";
+        case LogLevel::ERROR:   return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
 Logger::Logger(LogLevel logLevel_):
     logLevel { logLevel_ },
     outStream { std::cerr } {
@@ -14,29 +24,39 @@ Logger::Logger(LogLevel logLevel_, std::ostream& outStream_):
 
 void Logger::Debug(const std::string& msg) {
     if (logLevel <= LogLevel::DEBUG) {
-        std::string logMsg = CreateLogMessage("DEBUG", msg);
-        Log(logMsg);
+        Submit(LogLevel::DEBUG, msg);
     }
 }
 
 void Logger::Info(const std::string& msg) {
     if (logLevel <= LogLevel::INFO) {
-        std::string logMsg = CreateLogMessage("INFO", msg);
-        Log(logMsg);
+        Submit(LogLevel::INFO, msg);
     }
 }
 
 void Logger::Warn(const std::string& msg) {
     if (logLevel <= LogLevel::WARN) {
-        std::string logMsg = CreateLogMessage("WARN", msg);
-        Log(logMsg);
+        Submit(LogLevel::WARN, msg);
     }
 }
 
 void Logger::Error(const std::string& msg) {
     if (logLevel <= LogLevel::ERROR) {
-        std::string logMsg = CreateLogMessage("ERROR", msg);
-        Log(logMsg);
+        Submit(LogLevel::ERROR, msg);
+    }
+}
+
+void Logger::Submit(LogLevel level, const std::string& msg) {
+    Log(CreateLogMessage(GetLevelName(level), msg));
+}
+
+void Logger::Flush() {
+    outStream.flush();
+}
+
+void Logger::Write(LogLevel level, const std::string& msg) {
+    if (logLevel <= level) {
+        Submit(level, msg);
     }
 }
 
@@ -66,11 +86,11 @@ std::string Logger::CreateLogMessage(const std::string& level, const std::string
 
     logMsg.resize(len);
 
-    return std::move(logMsg);
+    return logMsg;
 }
 
 void Logger::Log(const std::string& msg) {
-    std::cerr << msg << std::endl;
+    outStream << msg << std::endl;
 }
 
 }
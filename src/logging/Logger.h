@@ -19,23 +19,29 @@ enum class LogLevel {
     ERROR = 3
 };
 
+const char*         GetLevelName(LogLevel level);
+
 class Logger {
 
 protected:
     LogLevel        logLevel;
     std::ostream&   outStream;
 
+    virtual void    Submit(LogLevel level, const std::string& msg);
     virtual void    Log(const std::string& msg);
     std::string     CreateLogMessage(const std::string& level, const std::string& msg);
 
 public:
      explicit       Logger(LogLevel logLevel_);
                     Logger(LogLevel logLevel_, std::ostream& outStream_);
+     virtual        ~Logger() = default;
 
      void           Debug(const std::string& msg);
      void           Info(const std::string& msg);
      void           Warn(const std::string& msg);
      void           Error(const std::string& msg);
+     void           Write(LogLevel level, const std::string& msg);
+     virtual void   Flush();
 };
 
 }
@@ -2,6 +2,25 @@
 
 namespace logging {
 
-const std::unique_ptr<Logger> stdLogger = std::make_unique<Logger>(LogLevel::LOG_LEVEL);
+static BinaryLogger* createdBinaryLogger = nullptr;
+
+// Filtering happens per category in the LOG macros, the logger itself passes everything
+static std::unique_ptr<Logger> CreateStdLogger() {
+    LoadLogLevelsFromEnvironment();
+    if (binaryStdLogger) {
+        auto logger = std::make_unique<BinaryLogger>(LogLevel::DEBUG, binaryLogFilename, binaryLogMaxSize);
+        createdBinaryLogger = logger.get();
+        return logger;
+    }
+    if (asyncStdLogger) {
+        auto logger = std::make_unique<AsyncLogger>(LogLevel::DEBUG, std::cerr, asyncLoggerCapacity, OverflowPolicy::DROP);
+        AsyncLogger::InstallCrashHandler(logger.get());
+        return logger;
+    }
+    return std::make_unique<Logger>(LogLevel::DEBUG);
+}
+
+const std::unique_ptr<Logger> stdLogger = CreateStdLogger();
+BinaryLogger* const binaryLogger = createdBinaryLogger;
 
 }
@@ -3,33 +3,64 @@
 #include <memory>
 
 #include "Logger.h"
+#include "AsyncLogger.h"
+#include "BinaryLogger.h"
+#include "LogCategory.h"
+#include "Trace.h"
+#include "utility/Format.h"
 
 namespace logging {
 
+// Log from a background thread so render loop messages never block on stderr
+const bool asyncStdLogger = true;
+const size_t asyncLoggerCapacity = 1024;
+
+// Write binary records instead of text, decode them with the logdecode tool
+const bool binaryStdLogger = false;
+const char* const binaryLogFilename = "test-vulkan.blog";
+const size_t binaryLogMaxSize = 256 * 1024 * 1024;
+
 extern const std::unique_ptr<Logger> stdLogger;
+extern BinaryLogger* const binaryLogger;
 
 }
 
-#define LOG_LEVEL INFO
-
-#if LOG_LEVEL == DEBUG
-    #define DEBUG(msg) logging::stdLogger->Debug(msg)
-    #define INFO(msg) logging::stdLogger->Info(msg)
-    #define WARN(msg) logging::stdLogger->Warn(msg)
-    #define ERROR(msg) logging::stdLogger->Error(msg)
-#elif LOG_LEVEL == INFO
-    #define DEBUG(msg)
-    #define INFO(msg) logging::stdLogger->Info(msg)
-    #define WARN(msg) logging::stdLogger->Warn(msg)
-    #define ERROR(msg) logging::stdLogger->Error(msg)
-#elif LOG_LEVEL == WARN
-    #define DEBUG(msg)
-    #define INFO(msg)
-    #define WARN(msg) logging::stdLogger->Warn(msg)
-    #define ERROR(msg) logging::stdLogger->Error(msg)
-#elif LOG_LEVEL == ERROR
-    #define DEBUG(msg)
-    #define INFO(msg)
-    #define WARN(msg)
-    #define ERROR(msg) logging::stdLogger->Error(msg)
-#endif
+// Log calls check their category level first, so a disabled call costs one
+// relaxed atomic load and never evaluates msg. Categories are LogCategory
+// enumerators without the scope: LOG_DEBUG(SWAPCHAIN, FORMAT("%u images", count));
+#define LOG(category, level, msg) do { \
+    if (logging::IsLogEnabled(logging::LogCategory::category, logging::LogLevel::level)) { \
+        logging::stdLogger->Write(logging::LogLevel::level, msg); \
+    } \
+} while (0)
+
+#define LOG_DEBUG(category, msg) LOG(category, DEBUG, msg)
+#define LOG_INFO(category, msg) LOG(category, INFO, msg)
+#define LOG_WARN(category, msg) LOG(category, WARN, msg)
+#define LOG_ERROR(category, msg) LOG(category, ERROR, msg)
+
+#define DEBUG(msg) LOG_DEBUG(GENERAL, msg)
+#define INFO(msg) LOG_INFO(GENERAL, msg)
+#define WARN(msg) LOG_WARN(GENERAL, msg)
+#define ERROR(msg) LOG_ERROR(GENERAL, msg)
+
+// Format checked log calls which skip formatting entirely with the binary logger.
+// Every call site registers its format string on first use and then only
+// writes the format id, a timestamp and the raw arguments. Meant for per frame
+// paths and driver callbacks, setup and teardown messages stay on LOG_*.
+#define BLOG(category, level, format, ...) do { \
+    (void) FORMAT_CHECK(format, ##__VA_ARGS__); \
+    if (logging::IsLogEnabled(logging::LogCategory::category, logging::LogLevel::level)) { \
+        if (logging::binaryLogger != nullptr) { \
+            static const uint32_t blogFormatId = logging::binaryLogger->RegisterFormat(logging::LogLevel::level, format, __FILE__, __LINE__); \
+            logging::binaryLogger->WriteRecord(logging::LogLevel::level, blogFormatId, ##__VA_ARGS__); \
+        } else { \
+            logging::stdLogger->Write(logging::LogLevel::level, Format(format, ##__VA_ARGS__)); \
+        } \
+    } \
+} while (0)
+
+#define BLOG_DEBUG(category, format, ...) BLOG(category, DEBUG, format, ##__VA_ARGS__)
+#define BLOG_INFO(category, format, ...) BLOG(category, INFO, format, ##__VA_ARGS__)
+#define BLOG_WARN(category, format, ...) BLOG(category, WARN, format, ##__VA_ARGS__)
+#define BLOG_ERROR(category, format, ...) BLOG(category, ERROR, format, ##__VA_ARGS__)
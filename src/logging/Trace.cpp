@@ -0,0 +1,195 @@
+#include "Trace.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+
+#include "utility/Format.h"
+#include "StdLogger.h"
+
+namespace logging {
+
+struct TraceEvent {
+    const char*     name;
+    uint64_t        start;
+    uint64_t        end;
+};
+
+// Written by its thread only. The count of events ever recorded is published after
+// the event, event i lives in slot i % traceBufferCapacity. The writer of the trace
+// file copies without a lock and drops what may have been overwritten meanwhile.
+struct TraceBuffer {
+    uint32_t                        threadId;
+    std::atomic<const char*>        threadName;
+    std::atomic<size_t>             count;
+    std::unique_ptr<TraceEvent[]>   events;
+};
+
+static size_t GetOldestKept(size_t count) {
+    return count > traceBufferCapacity ? count - traceBufferCapacity : 0;
+}
+
+// Buffers stay around after their thread exits, so short lived threads like
+// the startup workers still show up. Writes the trace file on exit.
+class TraceRegistry {
+
+public:
+                            TraceRegistry();
+                            ~TraceRegistry();
+
+    TraceBuffer&            CreateBuffer();
+    bool                    Write(const std::string& filename);
+
+    const std::chrono::steady_clock::time_point start;
+
+private:
+    std::mutex                                  mutex;
+    std::vector<std::unique_ptr<TraceBuffer>>   buffers;
+    std::string                                 filename;
+};
+
+std::atomic<bool> tracingEnabled { false };
+
+static TraceRegistry registry;
+static thread_local TraceBuffer* threadBuffer = nullptr;
+
+TraceRegistry::TraceRegistry():
+    start { std::chrono::steady_clock::now() } {
+
+    const char* value = std::getenv(traceEnvVar);
+    if (value == nullptr || *value == 0 || std::string(value) == "0") {
+        return;
+    }
+    filename = std::string(value) == "1" ? defaultTraceFilename : value;
+    tracingEnabled = true;
+}
+
+TraceRegistry::~TraceRegistry() {
+    if (!tracingEnabled) {
+        return;
+    }
+    tracingEnabled = false;
+    if (!Write(filename)) {
+        std::cerr << "Could not write trace " << filename << std::endl;
+    }
+}
+
+TraceBuffer& TraceRegistry::CreateBuffer() {
+    std::lock_guard<std::mutex> lock { mutex };
+    auto buffer = std::make_unique<TraceBuffer>();
+
+    buffer->threadId = static_cast<uint32_t>(buffers.size() + 1);
+    buffer->threadName = nullptr;
+    buffer->count = 0;
+    buffer->events = std::make_unique<TraceEvent[]>(traceBufferCapacity);
+    buffers.push_back(std::move(buffer));
+    return *buffers.back();
+}
+
+static void WriteJsonString(std::ofstream& out, const char* str) {
+    out << '"';
+    for (; *str != 0; str++) {
+        if (*str == '"' || *str == '\\') {
+            out << '\\';
+        }
+        out << *str;
+    }
+    out << '"';
+}
+
+bool TraceRegistry::Write(const std::string& filename_) {
+    std::lock_guard<std::mutex> lock { mutex };
+    std::ofstream out { filename_ };
+    // runs at exit, after the thread local buffer of FORMAT is gone
+    char line[256];
+    bool first = true;
+    uint64_t dropped = 0;
+    std::vector<TraceEvent> events;
+
+    if (!out) {
+        return false;
+    }
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (const auto& buffer: buffers) {
+        const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        size_t oldest = GetOldestKept(count);
+
+        events.clear();
+        for (size_t i = oldest; i < count; i++) {
+            events.push_back(buffer->events[i & (traceBufferCapacity - 1)]);
+        }
+        // the thread may still be recording, the event after the last published one overwrites a slot
+        std::atomic_thread_fence(std::memory_order_acquire);
+        size_t valid = GetOldestKept(buffer->count.load(std::memory_order_relaxed) + 1);
+        size_t skipped = valid > oldest ? std::min(valid - oldest, events.size()) : 0;
+
+        if (threadName != nullptr) {
+            FORMAT_TO(line, sizeof(line), "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", buffer->threadId);
+            out << (first ? "" : ",\n") << line;
+            WriteJsonString(out, threadName);
+            out << "}}";
+            first = false;
+        }
+        // timestamps are microseconds, the fraction keeps the nanoseconds
+        for (size_t i = skipped; i < events.size(); i++) {
+            const TraceEvent& event = events[i];
+
+            out << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+            WriteJsonString(out, event.name);
+            FORMAT_TO(line, sizeof(line), ",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                buffer->threadId,
+                event.start / 1000.0,
+                (event.end - event.start) / 1000.0);
+            out << line;
+            first = false;
+        }
+        dropped += oldest + skipped;
+    }
+    FORMAT_TO(line, sizeof(line), "\n],\"otherData\":{\"droppedEvents\":%llu}}\n", static_cast<unsigned long long>(dropped));
+    out << line;
+    return static_cast<bool>(out);
+}
+
+uint64_t GetTraceTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - registry.start).count();
+}
+
+static TraceBuffer& GetThreadBuffer() {
+    if (threadBuffer == nullptr) {
+        threadBuffer = &registry.CreateBuffer();
+    }
+    return *threadBuffer;
+}
+
+void RecordTraceEvent(const char* name, uint64_t start, uint64_t end) {
+    TraceBuffer& buffer = GetThreadBuffer();
+    size_t index = buffer.count.load(std::memory_order_relaxed);
+
+    if (index == traceBufferCapacity) {
+        const char* threadName = buffer.threadName.load(std::memory_order_relaxed);
+
+        if (threadName != nullptr) {
+            LOG_WARN(GENERAL, FORMAT("Trace buffer of thread %s is full, only its last %u events will be kept", threadName, traceBufferCapacity));
+        } else {
+            LOG_WARN(GENERAL, FORMAT("Trace buffer of thread %u is full, only its last %u events will be kept", buffer.threadId, traceBufferCapacity));
+        }
+    }
+    buffer.events[index & (traceBufferCapacity - 1)] = TraceEvent { name, start, end };
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+void SetTraceThreadName(const char* name) {
+    if (IsTracing()) {
+        GetThreadBuffer().threadName.store(name, std::memory_order_release);
+    }
+}
+
+bool WriteTrace(const std::string& filename) {
+    return registry.Write(filename);
+}
+
+}
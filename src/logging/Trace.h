@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+namespace logging {
+
+// Tracing is off unless this variable is set, to a file name or to 1 for the default name.
+// Every thread records into its own ring, which is written out as Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev) when the program exits.
+const char* const traceEnvVar = "TV_TRACE";
+const char* const defaultTraceFilename = "test-vulkan.trace.json";
+// Events per thread, once a ring is full its oldest events make room, so a long run keeps its end
+const size_t traceBufferCapacity = 64 * 1024;
+
+static_assert((traceBufferCapacity & (traceBufferCapacity - 1)) == 0, "Trace buffer capacity has to be a power of two");
+
+extern std::atomic<bool> tracingEnabled;
+
+// The only check on the disabled path, one relaxed load
+inline bool IsTracing() {
+    return tracingEnabled.load(std::memory_order_relaxed);
+}
+
+// Nanoseconds on the steady clock since tracing started
+uint64_t GetTraceTime();
+// Name has to outlive the trace, string literals are fine
+void RecordTraceEvent(const char* name, uint64_t start, uint64_t end);
+// Shown instead of the thread id, set from the thread itself
+void SetTraceThreadName(const char* name);
+// Everything recorded so far, false if the file could not be written
+bool WriteTrace(const std::string& filename);
+
+// Records the time from construction to destruction as one complete event
+class TraceScope {
+
+public:
+    explicit                TraceScope(const char* name_):
+                                name { IsTracing() ? name_ : nullptr },
+                                start { name != nullptr ? GetTraceTime() : 0 } {
+                            }
+                            TraceScope(const TraceScope& other) = delete;
+                            ~TraceScope() {
+                                if (name != nullptr) {
+                                    RecordTraceEvent(name, start, GetTraceTime());
+                                }
+                            }
+
+    TraceScope&             operator=(const TraceScope& other) = delete;
+
+private:
+    const char*             name;
+    uint64_t                start;
+};
+
+}
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+// Traces the rest of the enclosing block: TRACE_SCOPE("Vulkan::LoadDevice");
+#define TRACE_SCOPE(name) logging::TraceScope TRACE_CONCAT(traceScope, __LINE__) { name }
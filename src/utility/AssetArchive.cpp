@@ -0,0 +1,151 @@
+#include "AssetArchive.h"
+
+AssetData::AssetData(const uint8_t* data_, size_t size_):
+    data { data_ },
+    size { size_ } {
+}
+
+AssetData::AssetData(std::vector<uint8_t>&& owned_):
+    data { nullptr },
+    size { owned_.size() },
+    owned { std::move(owned_) } {
+    data = owned.data();
+}
+
+AssetData::AssetData(AssetData&& other) noexcept:
+    data { other.data },
+    size { other.size },
+    owned { std::move(other.owned) } {
+    other.data = nullptr;
+    other.size = 0;
+}
+
+AssetData& AssetData::operator=(AssetData&& other) noexcept {
+    if (this != &other) {
+        data = other.data;
+        size = other.size;
+        owned = std::move(other.owned);
+        other.data = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+AssetArchive::AssetArchive(const std::string& filename_):
+    filename { filename_ },
+    file { filename_, AccessHint::RANDOM },
+    header { nullptr },
+    entries { nullptr },
+    slots { nullptr },
+    names { nullptr } {
+
+    if (file.GetSize() < sizeof(AssetArchiveHeader)) {
+        throw std::runtime_error("Could not read asset archive " + filename + ", file too small");
+    }
+    header = reinterpret_cast<const AssetArchiveHeader*>(file.GetData());
+    Validate();
+    entries = reinterpret_cast<const AssetArchiveEntry*>(file.GetData() + header->entryTableOffset);
+    slots = reinterpret_cast<const uint32_t*>(file.GetData() + header->slotTableOffset);
+    names = reinterpret_cast<const char*>(file.GetData() + header->nameTableOffset);
+
+    // the tables are hit on every lookup, the entry data only when read
+    file.Advise(AccessHint::WILL_NEED, 0, header->nameTableOffset + header->nameTableSize);
+}
+
+static bool InBounds(uint64_t offset, uint64_t length, uint64_t size) {
+    return offset <= size && length <= size - offset;
+}
+
+void AssetArchive::Validate() const {
+    uint64_t size = file.GetSize();
+
+    if (std::memcmp(header->magic, assetArchiveMagic, sizeof(assetArchiveMagic)) != 0) {
+        throw std::runtime_error("Could not read asset archive " + filename + ", bad magic");
+    }
+    if (header->version != assetArchiveVersion) {
+        throw std::runtime_error("Could not read asset archive " + filename + ", unsupported version");
+    }
+    if (header->slotCount == 0 || (header->slotCount & (header->slotCount - 1)) != 0 ||
+        header->slotCount <= header->entryCount) {
+        throw std::runtime_error("Could not read asset archive " + filename + ", bad slot table");
+    }
+    if (header->entryTableOffset % alignof(AssetArchiveEntry) != 0 ||
+        header->slotTableOffset % alignof(uint32_t) != 0 ||
+        !InBounds(header->entryTableOffset, uint64_t(header->entryCount) * sizeof(AssetArchiveEntry), size) ||
+        !InBounds(header->slotTableOffset, uint64_t(header->slotCount) * sizeof(uint32_t), size) ||
+        !InBounds(header->nameTableOffset, header->nameTableSize, size)) {
+        throw std::runtime_error("Could not read asset archive " + filename + ", truncated tables");
+    }
+
+    auto archiveEntries = reinterpret_cast<const AssetArchiveEntry*>(file.GetData() + header->entryTableOffset);
+    for (uint32_t i = 0; i < header->entryCount; i++) {
+        const AssetArchiveEntry& entry = archiveEntries[i];
+
+        if (!InBounds(entry.offset, entry.storedSize, size) ||
+            !InBounds(entry.nameOffset, entry.nameLength, header->nameTableSize) ||
+            entry.offset % assetArchiveAlignment != 0) {
+            throw std::runtime_error("Could not read asset archive " + filename + ", bad entry");
+        }
+    }
+
+    // a slot table without an empty slot would have lookups of missing names wrap around forever
+    auto archiveSlots = reinterpret_cast<const uint32_t*>(file.GetData() + header->slotTableOffset);
+    uint32_t occupied = 0;
+    for (uint32_t i = 0; i < header->slotCount; i++) {
+        if (archiveSlots[i] > header->entryCount) {
+            throw std::runtime_error("Could not read asset archive " + filename + ", bad slot table");
+        }
+        occupied += archiveSlots[i] != 0 ? 1 : 0;
+    }
+    if (occupied >= header->slotCount) {
+        throw std::runtime_error("Could not read asset archive " + filename + ", slot table full");
+    }
+}
+
+const AssetArchiveEntry* AssetArchive::Find(const std::string& name) const {
+    uint64_t hash = HashAssetName(name.data(), name.size());
+    uint32_t mask = header->slotCount - 1;
+    uint32_t slot = hash & mask;
+
+    // Validate made sure there is an empty slot, the probe count is only a second guard
+    for (uint32_t probes = 0; probes < header->slotCount && slots[slot] != 0; probes++, slot = (slot + 1) & mask) {
+        const AssetArchiveEntry& entry = entries[slots[slot] - 1];
+
+        if (entry.nameHash == hash &&
+            entry.nameLength == name.size() &&
+            std::memcmp(names + entry.nameOffset, name.data(), name.size()) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+AssetData AssetArchive::Read(const std::string& name) const {
+    const AssetArchiveEntry* entry = Find(name);
+
+    if (entry == nullptr) {
+        throw std::runtime_error("Could not find asset " + name + " in " + filename);
+    }
+    return Read(*entry);
+}
+
+AssetData AssetArchive::Read(const AssetArchiveEntry& entry) const {
+    const uint8_t* stored = file.GetData() + entry.offset;
+
+    switch (static_cast<AssetCompression>(entry.compression)) {
+        case AssetCompression::NONE:
+            return AssetData { stored, static_cast<size_t>(entry.storedSize) };
+        case AssetCompression::LZ: {
+            std::vector<uint8_t> buffer(entry.size);
+
+            if (!DecompressBlock(stored, entry.storedSize, buffer.data(), buffer.size())) {
+                throw std::runtime_error("Could not decompress asset " +
+                    std::string(names + entry.nameOffset, entry.nameLength) + " in " + filename);
+            }
+            return AssetData { std::move(buffer) };
+        }
+        default:
+            throw std::runtime_error("Could not read asset " +
+                std::string(names + entry.nameOffset, entry.nameLength) + ", unknown compression");
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstring>
+
+#include "AssetArchiveFormat.h"
+#include "Compression.h"
+#include "File.h"
+
+// Contents of one archive entry. Stored entries point straight into the
+// archive mapping, compressed ones own their decompressed copy. Either way
+// the data is at least 16 byte aligned.
+class AssetData {
+
+public:
+                            AssetData(const uint8_t* data_, size_t size_);
+    explicit                AssetData(std::vector<uint8_t>&& owned_);
+                            AssetData(AssetData&& other) noexcept;
+                            AssetData(const AssetData& other) = delete;
+
+    AssetData&              operator=(AssetData&& other) noexcept;
+    AssetData&              operator=(const AssetData& other) = delete;
+
+    const uint8_t*          GetData() const { return data; }
+    size_t                  GetSize() const { return size; }
+
+private:
+    const uint8_t*          data;
+    size_t                  size;
+    std::vector<uint8_t>    owned;
+};
+
+// Read-only view of a packed asset archive, see AssetArchiveFormat.h.
+// The archive is mapped once, lookups hash the name and probe the slot table.
+class AssetArchive {
+
+public:
+    explicit                    AssetArchive(const std::string& filename);
+
+    const AssetArchiveEntry*    Find(const std::string& name) const;
+    bool                        Contains(const std::string& name) const { return Find(name) != nullptr; }
+    AssetData                   Read(const std::string& name) const;
+    AssetData                   Read(const AssetArchiveEntry& entry) const;
+
+    uint32_t                    GetEntryCount() const { return header->entryCount; }
+    const std::string&          GetFilename() const { return filename; }
+
+private:
+    std::string                 filename;
+    MappedFile                  file;
+    const AssetArchiveHeader*   header;
+    const AssetArchiveEntry*    entries;
+    const uint32_t*             slots;
+    const char*                 names;
+
+    void                        Validate() const;
+};
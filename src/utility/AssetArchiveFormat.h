@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// On disk layout of an asset archive, shared by the reader and the pack tool:
+//   header | entry table | slot table | name table | entry data...
+// The slot table is an open addressing hash table (linear probing, power of
+// two size) of entry index + 1, keyed by the FNV-1a hash of the entry name.
+// Entry data starts on 16 byte boundaries. All fields are little endian.
+
+const char          assetArchiveMagic[8] = { 'T', 'V', 'P', 'A', 'C', 'K', 0, 0 };
+const uint32_t      assetArchiveVersion = 1;
+const size_t        assetArchiveAlignment = 16;
+
+enum class AssetCompression: uint32_t {
+    NONE = 0,
+    LZ = 1
+};
+
+struct AssetArchiveHeader {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    entryCount;
+    uint32_t    slotCount;
+    uint32_t    nameTableSize;
+    uint64_t    entryTableOffset;
+    uint64_t    slotTableOffset;
+    uint64_t    nameTableOffset;
+};
+
+struct AssetArchiveEntry {
+    uint64_t    nameHash;
+    uint64_t    offset;
+    uint64_t    storedSize;
+    uint64_t    size;
+    uint32_t    nameOffset;
+    uint32_t    nameLength;
+    uint32_t    compression;
+    uint32_t    reserved;
+};
+
+static_assert(sizeof(AssetArchiveHeader) == 48, "Unexpected archive header size");
+static_assert(sizeof(AssetArchiveEntry) == 48, "Unexpected archive entry size");
+
+inline uint64_t HashAssetName(const char* name, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,131 @@
+#include "Compression.h"
+
+static const size_t minMatch = 4;
+static const size_t maxOffset = 65535;
+static const unsigned hashBits = 14;
+
+static uint32_t Read32(const uint8_t* ptr) {
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static uint32_t HashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - hashBits);
+}
+
+static void WriteLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+static void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength > 0 ? matchLength - minMatch : 0;
+    uint8_t token = static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15));
+
+    out.push_back(token);
+    if (literalLength >= 15) {
+        WriteLength(out, literalLength - 15);
+    }
+    out.insert(out.end(), literals, literals + literalLength);
+
+    if (matchLength > 0) {
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15) {
+            WriteLength(out, matchCode - 15);
+        }
+    }
+}
+
+std::vector<uint8_t> CompressBlock(const uint8_t* src, size_t size) {
+    std::vector<uint8_t> out;
+    std::vector<int64_t> table(size_t(1) << hashBits, -1);
+    size_t anchor = 0;
+    size_t pos = 0;
+
+    out.reserve(size / 2 + 16);
+    while (pos + minMatch <= size) {
+        uint32_t sequence = Read32(src + pos);
+        uint32_t hash = HashSequence(sequence);
+        int64_t candidate = table[hash];
+
+        table[hash] = static_cast<int64_t>(pos);
+        if (candidate >= 0 && pos - candidate <= maxOffset && Read32(src + candidate) == sequence) {
+            size_t length = minMatch;
+
+            while (pos + length < size && src[candidate + length] == src[pos + length]) {
+                length++;
+            }
+            WriteSequence(out, src + anchor, pos - anchor, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        } else {
+            pos++;
+        }
+    }
+    // trailing literals form the last sequence, which has no match
+    WriteSequence(out, src + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+static bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+
+    do {
+        if (in >= end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* in = src;
+    const uint8_t* inEnd = src + srcSize;
+    size_t outPos = 0;
+
+    while (in < inEnd) {
+        uint8_t token = *in++;
+        size_t literalLength = token >> 4;
+
+        if (literalLength == 15 && !ReadLength(in, inEnd, literalLength)) {
+            return false;
+        }
+        if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > dstSize - outPos) {
+            return false;
+        }
+        std::memcpy(dst + outPos, in, literalLength);
+        in += literalLength;
+        outPos += literalLength;
+
+        if (in == inEnd) {
+            break;
+        }
+        if (inEnd - in < 2) {
+            return false;
+        }
+        size_t offset = in[0] | (in[1] << 8);
+        size_t matchLength = token & 0x0F;
+
+        in += 2;
+        if (matchLength == 15 && !ReadLength(in, inEnd, matchLength)) {
+            return false;
+        }
+        matchLength += minMatch;
+        if (offset == 0 || offset > outPos || matchLength > dstSize - outPos) {
+            return false;
+        }
+        // byte wise on purpose, matches may overlap their own output
+        for (size_t i = 0; i < matchLength; i++) {
+            dst[outPos + i] = dst[outPos - offset + i];
+        }
+        outPos += matchLength;
+    }
+    return outPos == dstSize;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+// Small LZ77 block codec in the spirit of LZ4: sequences of a token byte
+// (literal length / match length nibbles), extended lengths, literals and
+// a 16 bit back reference. Fast to decode and needs no external library.
+
+std::vector<uint8_t> CompressBlock(const uint8_t* src, size_t size);
+
+// Returns false if src is malformed or does not expand to exactly dstSize bytes
+bool DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
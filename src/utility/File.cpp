@@ -1,5 +1,12 @@
 #include "File.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 
 std::vector<char> ReadFile(const std::string& filename) {
     std::ifstream f {filename, std::ios::ate | std::ios::binary };
@@ -16,3 +23,140 @@ std::vector<char> ReadFile(const std::string& filename) {
     f.close();
     return buffer;
 }
+
+bool FileExists(const std::string& filename) {
+    std::ifstream f { filename, std::ios::binary };
+    return f.is_open();
+}
+
+MappedFile::MappedFile():
+    data { nullptr },
+    size { 0 },
+    loaded { false },
+    mapped { false } {
+}
+
+MappedFile::MappedFile(const std::string& filename, AccessHint hint):
+    MappedFile() {
+
+    #ifdef __linux__
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info;
+
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not stat file " + filename);
+    }
+    size = static_cast<size_t>(info.st_size);
+
+    // mmap refuses empty mappings, an empty file is just an empty view
+    if (size > 0) {
+        void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (view == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Could not map file " + filename);
+        }
+        data = static_cast<const uint8_t*>(view);
+        mapped = true;
+    }
+    // the mapping keeps the file referenced
+    close(fd);
+    #else
+    std::ifstream f { filename, std::ios::ate | std::ios::binary };
+
+    if (!f.is_open()) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    fallback.resize(static_cast<size_t>(f.tellg()));
+    f.seekg(0);
+    f.read(reinterpret_cast<char*>(fallback.data()), fallback.size());
+    data = fallback.data();
+    size = fallback.size();
+    #endif
+
+    loaded = true;
+    Advise(hint);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept:
+    data { other.data },
+    size { other.size },
+    loaded { other.loaded },
+    mapped { other.mapped },
+    fallback { std::move(other.fallback) } {
+
+    if (!mapped && loaded) {
+        data = fallback.data();
+    }
+    other.data = nullptr;
+    other.size = 0;
+    other.loaded = false;
+    other.mapped = false;
+}
+
+MappedFile::~MappedFile() {
+    Release();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Release();
+        data = other.data;
+        size = other.size;
+        loaded = other.loaded;
+        mapped = other.mapped;
+        fallback = std::move(other.fallback);
+        if (!mapped && loaded) {
+            data = fallback.data();
+        }
+        other.data = nullptr;
+        other.size = 0;
+        other.loaded = false;
+        other.mapped = false;
+    }
+    return *this;
+}
+
+void MappedFile::Advise(AccessHint hint) const {
+    Advise(hint, 0, size);
+}
+
+void MappedFile::Advise(AccessHint hint, size_t offset, size_t length) const {
+    #ifdef __linux__
+    if (!mapped || offset >= size) {
+        return;
+    }
+    int advice = MADV_NORMAL;
+
+    switch (hint) {
+        case AccessHint::NORMAL:        advice = MADV_NORMAL; break;
+        case AccessHint::SEQUENTIAL:    advice = MADV_SEQUENTIAL; break;
+        case AccessHint::RANDOM:        advice = MADV_RANDOM; break;
+        case AccessHint::WILL_NEED:     advice = MADV_WILLNEED; break;
+    }
+
+    // madvise wants a page aligned start
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t start = offset / pageSize * pageSize;
+    size_t end = std::min(size, offset + length);
+
+    madvise(const_cast<uint8_t*>(data) + start, end - start, advice);
+    #endif
+}
+
+void MappedFile::Release() {
+    #ifdef __linux__
+    if (mapped) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+    #endif
+    data = nullptr;
+    size = 0;
+    loaded = false;
+    mapped = false;
+    fallback.clear();
+}
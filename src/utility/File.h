@@ -4,5 +4,47 @@
 #include <string>
 #include <stdexcept>
 #include <fstream>
+#include <cstdint>
+#include <algorithm>
 
 std::vector<char> ReadFile(const std::string& filename);
+bool FileExists(const std::string& filename);
+
+enum class AccessHint {
+    NORMAL,
+    SEQUENTIAL,
+    RANDOM,
+    WILL_NEED
+};
+
+// Read-only view of a whole file. On Linux the file is mmapped, so the data is
+// page aligned and paged in on demand without a copy; elsewhere it is read into
+// an owned buffer. The mapping is released with the object.
+class MappedFile {
+
+public:
+                        MappedFile();
+    explicit            MappedFile(const std::string& filename, AccessHint hint = AccessHint::NORMAL);
+                        MappedFile(MappedFile&& other) noexcept;
+                        MappedFile(const MappedFile& other) = delete;
+                        ~MappedFile();
+
+    MappedFile&         operator=(MappedFile&& other) noexcept;
+    MappedFile&         operator=(const MappedFile& other) = delete;
+
+    void                Advise(AccessHint hint) const;
+    void                Advise(AccessHint hint, size_t offset, size_t length) const;
+
+    const uint8_t*      GetData() const { return data; }
+    size_t              GetSize() const { return size; }
+    bool                IsOpen() const { return loaded; }
+
+private:
+    const uint8_t*          data;
+    size_t                  size;
+    bool                    loaded;
+    bool                    mapped;
+    std::vector<uint8_t>    fallback;
+
+    void                Release();
+};
@@ -0,0 +1,241 @@
+#include "Format.h"
+
+#include <cstdio>
+
+namespace formatting {
+
+FormatBuffer::FormatBuffer(char* data_, size_t capacity_):
+    data { data_ },
+    capacity { capacity_ },
+    target { nullptr },
+    length { 0 } {
+}
+
+FormatBuffer::FormatBuffer(std::string& target_):
+    data { nullptr },
+    capacity { 0 },
+    target { &target_ },
+    length { target_.size() } {
+}
+
+void FormatBuffer::Append(const char* str, size_t count) {
+    if (target != nullptr) {
+        target->append(str, count);
+    } else if (length + 1 < capacity) {
+        std::memcpy(data + length, str, std::min(count, capacity - 1 - length));
+    }
+    length += count;
+}
+
+void FormatBuffer::Append(char c, size_t count) {
+    if (target != nullptr) {
+        target->append(count, c);
+    } else if (length + 1 < capacity) {
+        std::memset(data + length, c, std::min(count, capacity - 1 - length));
+    }
+    length += count;
+}
+
+void FormatBuffer::Terminate() {
+    if (target == nullptr && capacity > 0) {
+        data[std::min(length, capacity - 1)] = 0;
+    }
+}
+
+std::string& GetThreadBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+const char* AppendLiteral(FormatBuffer& buffer, const char* format) {
+    for (;;) {
+        const char* start = format;
+
+        while (*format != 0 && *format != '%') {
+            format++;
+        }
+        buffer.Append(start, format - start);
+        if (*format == 0) {
+            return format;
+        }
+        if (format[1] != '%') {
+            return format;
+        }
+        buffer.Append('%', 1);
+        format += 2;
+    }
+}
+
+const char* ParseSpec(const char* format, FormatSpec& spec) {
+    spec.precision = -1;
+    format++;
+
+    while (IsFlag(*format)) {
+        spec.leftAlign |= *format == '-';
+        spec.zeroPad |= *format == '0';
+        spec.forceSign |= *format == '+';
+        spec.spaceSign |= *format == ' ';
+        spec.alternate |= *format == '#';
+        format++;
+    }
+    while (IsDigit(*format)) {
+        spec.width = spec.width * 10 + (*format - '0');
+        format++;
+    }
+    if (*format == '.') {
+        spec.precision = 0;
+        format++;
+        while (IsDigit(*format)) {
+            spec.precision = spec.precision * 10 + (*format - '0');
+            format++;
+        }
+    }
+    while (IsLengthModifier(*format)) {
+        format++;
+    }
+    spec.conversion = *format;
+    return *format != 0 ? format + 1 : format;
+}
+
+// Pads prefix (sign or 0x), leading zeros and digits out to the spec width
+static void AppendPadded(FormatBuffer& buffer, const FormatSpec& spec, const char* prefix, size_t prefixCount, size_t zeros, const char* digits, size_t count) {
+    size_t used = prefixCount + zeros + count;
+    size_t padding = spec.width > 0 && static_cast<size_t>(spec.width) > used ? spec.width - used : 0;
+
+    if (!spec.leftAlign && !spec.zeroPad) {
+        buffer.Append(' ', padding);
+    }
+    buffer.Append(prefix, prefixCount);
+    if (!spec.leftAlign && spec.zeroPad) {
+        buffer.Append('0', padding);
+    }
+    buffer.Append('0', zeros);
+    buffer.Append(digits, count);
+    if (spec.leftAlign) {
+        buffer.Append(' ', padding);
+    }
+}
+
+static size_t WriteDigits(char* end, unsigned long long value, unsigned base, bool upper) {
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char* pos = end;
+
+    do {
+        *--pos = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    return end - pos;
+}
+
+static unsigned GetBase(char conversion) {
+    switch (conversion) {
+        case 'x': case 'X': case 'p':
+            return 16;
+        case 'o':
+            return 8;
+        default:
+            return 10;
+    }
+}
+
+// Digits with the precision as minimum digit count, which also turns off zero padding
+static void AppendInteger(FormatBuffer& buffer, const FormatSpec& spec, const char* prefix, size_t prefixCount, unsigned long long value) {
+    char digits[24];
+    unsigned base = GetBase(spec.conversion);
+    size_t count = WriteDigits(digits + sizeof(digits), value, base, spec.conversion == 'X');
+    FormatSpec numberSpec { spec };
+    size_t zeros = 0;
+
+    if (spec.precision >= 0) {
+        numberSpec.zeroPad = false;
+        if (spec.precision == 0 && value == 0) {
+            count = 0;
+        }
+        zeros = static_cast<size_t>(spec.precision) > count ? spec.precision - count : 0;
+    }
+    // %#o always starts with a 0
+    if (spec.alternate && base == 8 && zeros == 0 && (count == 0 || digits[sizeof(digits) - count] != '0')) {
+        zeros = 1;
+    }
+    AppendPadded(buffer, numberSpec, prefix, prefixCount, zeros, digits + sizeof(digits) - count, count);
+}
+
+void FormatSigned(FormatBuffer& buffer, const FormatSpec& spec, long long value) {
+    if (spec.conversion != 'd' && spec.conversion != 'i') {
+        FormatUnsigned(buffer, spec, static_cast<unsigned long long>(value));
+        return;
+    }
+    unsigned long long magnitude = value < 0 ? 0ull - static_cast<unsigned long long>(value) : value;
+    char sign = value < 0 ? '-' : (spec.forceSign ? '+' : ' ');
+    bool hasSign = value < 0 || spec.forceSign || spec.spaceSign;
+
+    AppendInteger(buffer, spec, &sign, hasSign ? 1 : 0, magnitude);
+}
+
+void FormatUnsigned(FormatBuffer& buffer, const FormatSpec& spec, unsigned long long value) {
+    bool hexPrefix = spec.alternate && value != 0 && (spec.conversion == 'x' || spec.conversion == 'X');
+
+    AppendInteger(buffer, spec, spec.conversion == 'X' ? "0X" : "0x", hexPrefix ? 2 : 0, value);
+}
+
+// Rounding decimal digits exactly is not worth redoing, snprintf gets every flag right
+void FormatFloat(FormatBuffer& buffer, const FormatSpec& spec, double value) {
+    char format[16];
+    char* pos = format;
+
+    *pos++ = '%';
+    if (spec.leftAlign) {
+        *pos++ = '-';
+    }
+    if (spec.forceSign) {
+        *pos++ = '+';
+    }
+    if (spec.spaceSign) {
+        *pos++ = ' ';
+    }
+    if (spec.alternate) {
+        *pos++ = '#';
+    }
+    if (spec.zeroPad) {
+        *pos++ = '0';
+    }
+    *pos++ = '*';
+    *pos++ = '.';
+    *pos++ = '*';
+    *pos++ = spec.conversion == 'F' ? 'F' : 'f';
+    *pos = 0;
+
+    char digits[64];
+    int precision = spec.precision < 0 ? 6 : spec.precision;
+    int count = std::snprintf(digits, sizeof(digits), format, spec.width, precision, value);
+
+    if (count < 0) {
+        return;
+    }
+    if (static_cast<size_t>(count) < sizeof(digits)) {
+        buffer.Append(digits, count);
+        return;
+    }
+    // huge values or widths
+    std::string large(count + 1, 0);
+    std::snprintf(&large[0], large.size(), format, spec.width, precision, value);
+    buffer.Append(large.data(), count);
+}
+
+void FormatString(FormatBuffer& buffer, const FormatSpec& spec, const char* str, size_t length) {
+    if (spec.precision >= 0) {
+        length = std::min(length, static_cast<size_t>(spec.precision));
+    }
+    FormatSpec textSpec { spec };
+    textSpec.zeroPad = false;
+    AppendPadded(buffer, textSpec, "", 0, 0, str, length);
+}
+
+void FormatPointer(FormatBuffer& buffer, const FormatSpec& spec, const void* ptr) {
+    char digits[24];
+    size_t count = WriteDigits(digits + sizeof(digits), reinterpret_cast<uintptr_t>(ptr), 16, false);
+
+    AppendPadded(buffer, spec, "0x", 2, 0, digits + sizeof(digits) - count, count);
+}
+
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+#include <cmath>
+
+// Printf style formatting without varargs. Arguments are formatted by their
+// real type, and the FORMAT macros check the format string against the
+// argument types at compile time:
+//   LOG_INFO(VULKAN, FORMAT("Used device: %s", device->GetName()));
+// Length modifiers (l, ll, z, ...) are accepted but not needed.
+
+namespace formatting {
+
+enum class ArgKind {
+    NONE,
+    INTEGER,
+    CHAR,
+    BOOL,
+    FLOAT,
+    STRING,
+    POINTER,
+    OTHER
+};
+
+template<typename T>
+constexpr ArgKind GetArgKind() {
+    using U = std::remove_cv_t<std::decay_t<T>>;
+    return std::is_same<U, bool>::value ? ArgKind::BOOL :
+        std::is_same<U, char>::value ? ArgKind::CHAR :
+        std::is_integral<U>::value ? ArgKind::INTEGER :
+        std::is_floating_point<U>::value ? ArgKind::FLOAT :
+        std::is_same<U, const char*>::value || std::is_same<U, char*>::value || std::is_same<U, std::string>::value ? ArgKind::STRING :
+        std::is_pointer<U>::value ? ArgKind::POINTER :
+        ArgKind::OTHER;
+}
+
+template<typename... Args>
+struct ArgList {
+    static constexpr size_t     count = sizeof...(Args);
+    static constexpr ArgKind    kinds[sizeof...(Args) + 1] = { GetArgKind<Args>()..., ArgKind::NONE };
+};
+
+template<typename... Args>
+constexpr ArgKind ArgList<Args...>::kinds[];
+
+// Only used in unevaluated context to turn the macro arguments into an ArgList
+template<typename... Args>
+ArgList<std::decay_t<Args>...> DeduceArgs(const Args&...);
+
+constexpr bool IsFlag(char c) {
+    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+}
+
+constexpr bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool IsLengthModifier(char c) {
+    return c == 'h' || c == 'l' || c == 'j' || c == 'z' || c == 't' || c == 'L';
+}
+
+constexpr bool Accepts(char conversion, ArgKind kind) {
+    switch (conversion) {
+        case 'd': case 'i':
+        case 'u': case 'x': case 'X': case 'o':
+            return kind == ArgKind::INTEGER || kind == ArgKind::CHAR || kind == ArgKind::BOOL;
+        case 'c':
+            return kind == ArgKind::CHAR || kind == ArgKind::INTEGER;
+        case 'f': case 'F':
+            return kind == ArgKind::FLOAT;
+        case 's':
+            return kind == ArgKind::STRING || kind == ArgKind::BOOL;
+        case 'p':
+            return kind == ArgKind::POINTER || kind == ArgKind::STRING;
+        default:
+            return false;
+    }
+}
+
+// Walks the format string once, matching every conversion to the next argument kind
+template<typename List>
+constexpr bool CheckFormat(const char* format, List) {
+    size_t arg = 0;
+
+    for (size_t i = 0; format[i] != 0; i++) {
+        if (format[i] != '%') {
+            continue;
+        }
+        i++;
+        if (format[i] == '%') {
+            continue;
+        }
+        while (IsFlag(format[i])) {
+            i++;
+        }
+        while (IsDigit(format[i])) {
+            i++;
+        }
+        if (format[i] == '.') {
+            i++;
+            while (IsDigit(format[i])) {
+                i++;
+            }
+        }
+        while (IsLengthModifier(format[i])) {
+            i++;
+        }
+        if (arg >= List::count || !Accepts(format[i], List::kinds[arg])) {
+            return false;
+        }
+        arg++;
+    }
+    return arg == List::count;
+}
+
+struct FormatSpec {
+    bool        leftAlign;
+    bool        zeroPad;
+    bool        forceSign;
+    bool        spaceSign;
+    bool        alternate;
+    int         width;
+    int         precision;
+    char        conversion;
+};
+
+// Output sink, either a fixed caller buffer (truncating) or a growable string
+class FormatBuffer {
+
+public:
+                        FormatBuffer(char* data_, size_t capacity_);
+    explicit            FormatBuffer(std::string& target_);
+
+    void                Append(const char* str, size_t count);
+    void                Append(char c, size_t count);
+    void                Terminate();
+    size_t              GetLength() const { return length; }
+
+private:
+    char*               data;
+    size_t              capacity;
+    std::string*        target;
+    size_t              length;
+};
+
+const char* ParseSpec(const char* format, FormatSpec& spec);
+const char* AppendLiteral(FormatBuffer& buffer, const char* format);
+
+void FormatSigned(FormatBuffer& buffer, const FormatSpec& spec, long long value);
+void FormatUnsigned(FormatBuffer& buffer, const FormatSpec& spec, unsigned long long value);
+void FormatFloat(FormatBuffer& buffer, const FormatSpec& spec, double value);
+void FormatString(FormatBuffer& buffer, const FormatSpec& spec, const char* str, size_t length);
+void FormatPointer(FormatBuffer& buffer, const FormatSpec& spec, const void* ptr);
+
+// %x, %o and %u take the bits of the promoted type, as printf does: -1 is ffffffff as an int
+template<typename T>
+std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value>
+FormatArg(FormatBuffer& buffer, const FormatSpec& spec, T value) {
+    if (spec.conversion == 'c') {
+        char c = static_cast<char>(value);
+        FormatString(buffer, spec, &c, 1);
+    } else if (spec.conversion == 'd' || spec.conversion == 'i') {
+        FormatSigned(buffer, spec, value);
+    } else {
+        FormatUnsigned(buffer, spec, static_cast<std::make_unsigned_t<decltype(+value)>>(value));
+    }
+}
+
+template<typename T>
+std::enable_if_t<std::is_integral<T>::value && !std::is_signed<T>::value && !std::is_same<T, bool>::value>
+FormatArg(FormatBuffer& buffer, const FormatSpec& spec, T value) {
+    if (spec.conversion == 'c') {
+        char c = static_cast<char>(value);
+        FormatString(buffer, spec, &c, 1);
+    } else {
+        FormatUnsigned(buffer, spec, value);
+    }
+}
+
+inline void FormatArg(FormatBuffer& buffer, const FormatSpec& spec, bool value) {
+    if (spec.conversion == 's') {
+        FormatString(buffer, spec, value ? "true" : "false", value ? 4 : 5);
+    } else {
+        FormatUnsigned(buffer, spec, value ? 1 : 0);
+    }
+}
+
+inline void FormatArg(FormatBuffer& buffer, const FormatSpec& spec, double value) {
+    FormatFloat(buffer, spec, value);
+}
+
+inline void FormatArg(FormatBuffer& buffer, const FormatSpec& spec, const char* str) {
+    if (spec.conversion == 'p') {
+        FormatPointer(buffer, spec, str);
+    } else {
+        FormatString(buffer, spec, str != nullptr ? str : "(null)", str != nullptr ? std::strlen(str) : 6);
+    }
+}
+
+inline void FormatArg(FormatBuffer& buffer, const FormatSpec& spec, const std::string& str) {
+    FormatString(buffer, spec, str.data(), str.size());
+}
+
+inline void FormatArg(FormatBuffer& buffer, const FormatSpec& spec, const void* ptr) {
+    FormatPointer(buffer, spec, ptr);
+}
+
+inline void FormatAll(FormatBuffer& buffer, const char* format) {
+    AppendLiteral(buffer, format);
+}
+
+template<typename T, typename... Rest>
+void FormatAll(FormatBuffer& buffer, const char* format, const T& first, const Rest&... rest) {
+    FormatSpec spec {};
+
+    format = AppendLiteral(buffer, format);
+    if (*format == 0) {
+        return;
+    }
+    format = ParseSpec(format, spec);
+    FormatArg(buffer, spec, first);
+    FormatAll(buffer, format, rest...);
+}
+
+std::string& GetThreadBuffer();
+
+// Whether an argument points into the thread buffer, as the result of a nested FORMAT does
+template<typename T>
+bool AliasesBuffer(const std::string&, const T&) {
+    return false;
+}
+
+inline bool AliasesBuffer(const std::string& buffer, const std::string& str) {
+    return &str == &buffer;
+}
+
+inline bool AliasesBuffer(const std::string& buffer, const char* str) {
+    uintptr_t begin = reinterpret_cast<uintptr_t>(buffer.data());
+    uintptr_t pos = reinterpret_cast<uintptr_t>(str);
+
+    return pos >= begin && pos <= begin + buffer.capacity();
+}
+
+inline bool AliasesBuffer(const std::string& buffer, char* str) {
+    return AliasesBuffer(buffer, static_cast<const char*>(str));
+}
+
+inline bool AnyAliasesBuffer(const std::string&) {
+    return false;
+}
+
+template<typename T, typename... Rest>
+bool AnyAliasesBuffer(const std::string& buffer, const T& first, const Rest&... rest) {
+    return AliasesBuffer(buffer, first) || AnyAliasesBuffer(buffer, rest...);
+}
+
+template<bool valid>
+struct CheckedFormat {
+    static_assert(valid, "Format string does not match argument types");
+};
+
+}
+
+// Formats into buffer, truncating at capacity - 1 characters, and returns the untruncated length
+template<typename... Args>
+size_t FormatTo(char* buffer, size_t capacity, const char* format, const Args&... args) {
+    formatting::FormatBuffer out { buffer, capacity };
+    formatting::FormatAll(out, format, args...);
+    out.Terminate();
+    return out.GetLength();
+}
+
+// Formats into a thread local buffer. The result stays valid until the next Format call on this thread,
+// and may itself be passed to Format.
+template<typename... Args>
+const std::string& Format(const char* format, const Args&... args) {
+    std::string& target = formatting::GetThreadBuffer();
+
+    // clearing the buffer would destroy the argument, format aside and swap instead
+    if (formatting::AnyAliasesBuffer(target, args...)) {
+        std::string result;
+        formatting::FormatBuffer out { result };
+        formatting::FormatAll(out, format, args...);
+        target.swap(result);
+        return target;
+    }
+    target.clear();
+    formatting::FormatBuffer out { target };
+    formatting::FormatAll(out, format, args...);
+    return target;
+}
+
+#define FORMAT_CHECK(format, ...) \
+    formatting::CheckedFormat<formatting::CheckFormat(format, decltype(formatting::DeduceArgs(__VA_ARGS__)) {})> {}
+
+#define FORMAT(format, ...) \
+    ((void) FORMAT_CHECK(format, ##__VA_ARGS__), Format(format, ##__VA_ARGS__))
+
+#define FORMAT_TO(buffer, capacity, format, ...) \
+    ((void) FORMAT_CHECK(format, ##__VA_ARGS__), FormatTo(buffer, capacity, format, ##__VA_ARGS__))
@@ -0,0 +1,210 @@
+#include "JobSystem.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// the job system a thread works for, and its index there
+static thread_local const JobSystem* currentSystem = nullptr;
+static thread_local int currentWorker = -1;
+
+static void PinThread(size_t index) {
+    #ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(static_cast<int>(index % std::max(1u, std::thread::hardware_concurrency())), &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    #else
+    (void) index;
+    #endif
+}
+
+// xorshift, victims only have to be spread out, not random
+static uint32_t NextRandom(uint32_t& seed) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+JobSystem::JobSystem(size_t workerCount, bool pinWorkers):
+    injectedCount { 0 },
+    sleeping { 0 },
+    running { true },
+    steals { 0 } {
+
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    // every deque exists before the first worker looks for a victim
+    for (size_t i = 0; i < workerCount; i++) {
+        workers[i]->thread = std::thread { &JobSystem::WorkerLoop, this, i, pinWorkers };
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock { mutex };
+        running = false;
+        wake.notify_all();
+    }
+    for (auto& worker: workers) {
+        worker->thread.join();
+    }
+    uint32_t seed = 1;
+    while (TryRunOne(seed)) {
+    }
+}
+
+size_t JobSystem::GetDefaultWorkerCount() {
+    return std::max(1u, std::thread::hardware_concurrency()) - 1;
+}
+
+int JobSystem::GetCurrentWorker() const {
+    return currentSystem == this ? currentWorker : -1;
+}
+
+void JobSystem::Run(std::function<void()> job, JobCounter& counter) {
+    int worker = GetCurrentWorker();
+
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    Job* created = new Job { std::move(job), &counter };
+
+    if (worker >= 0) {
+        if (!workers[worker]->deque.TryPush(created)) {
+            Execute(created);
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock { mutex };
+        injected.push_back(created);
+        injectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    Notify();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    uint32_t seed = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&counter)) | 1;
+
+    while (counter.pending.load(std::memory_order_acquire) != 0) {
+        if (!TryRunOne(seed)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body) {
+    JobCounter counter;
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    for (size_t first = begin; first < end; first += std::min(grainSize, end - first)) {
+        size_t last = first + std::min(grainSize, end - first);
+
+        // the last chunk is not worth a job, this thread would only wait otherwise
+        if (last == end) {
+            body(first, last);
+            break;
+        }
+        Run([&body, first, last]() { body(first, last); }, counter);
+    }
+    Wait(counter);
+}
+
+void JobSystem::WorkerLoop(size_t index, bool pin) {
+    uint32_t seed = static_cast<uint32_t>(index * 2654435761u) | 1;
+    size_t idleSpins = 0;
+
+    currentSystem = this;
+    currentWorker = static_cast<int>(index);
+    if (pin) {
+        PinThread(index);
+    }
+    while (running.load(std::memory_order_relaxed)) {
+        if (TryRunOne(seed)) {
+            idleSpins = 0;
+        } else if (++idleSpins < jobIdleSpins) {
+            std::this_thread::yield();
+        } else {
+            Sleep();
+            idleSpins = 0;
+        }
+    }
+}
+
+// Notify checks the sleeper count after queueing and a sleeper checks for work after
+// registering, both sequentially consistent, so one of them always sees the other
+void JobSystem::Sleep() {
+    std::unique_lock<std::mutex> lock { mutex };
+
+    sleeping.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wake.wait(lock, [this]() { return !running.load(std::memory_order_relaxed) || HasWork(); });
+    sleeping.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void JobSystem::Notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock { mutex };
+        wake.notify_one();
+    }
+}
+
+bool JobSystem::HasWork() const {
+    if (injectedCount.load(std::memory_order_relaxed) > 0) {
+        return true;
+    }
+    return std::any_of(workers.begin(), workers.end(), [](const std::unique_ptr<Worker>& worker) {
+        return worker->deque.GetSizeApprox() > 0;
+    });
+}
+
+JobSystem::Job* JobSystem::FindJob(uint32_t& seed) {
+    int worker = GetCurrentWorker();
+    Job* job = nullptr;
+
+    if (worker >= 0 && workers[worker]->deque.TryPop(job)) {
+        return job;
+    }
+    if (injectedCount.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock { mutex };
+        if (!injected.empty()) {
+            job = injected.front();
+            injected.pop_front();
+            injectedCount.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    // one pass over the others, starting at a random victim
+    size_t count = workers.size();
+    size_t start = count > 0 ? NextRandom(seed) % count : 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t victim = (start + i) % count;
+
+        if (static_cast<int>(victim) != worker && workers[victim]->deque.TrySteal(job)) {
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::TryRunOne(uint32_t& seed) {
+    Job* job = FindJob(seed);
+
+    if (job == nullptr) {
+        return false;
+    }
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Execute(Job* job) {
+    JobCounter* counter = job->counter;
+
+    job->function();
+    delete job;
+    counter->pending.fetch_sub(1, std::memory_order_release);
+}
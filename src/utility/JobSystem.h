@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <algorithm>
+
+#include "WorkStealingDeque.h"
+
+// Jobs per worker deque, a worker starting more runs the extra ones inline
+const size_t jobDequeCapacity = 4096;
+// How long an idle worker spins before sleeping until a job is queued
+const size_t jobIdleSpins = 64;
+
+// Counts the unfinished jobs started with it. It has to outlive them, so wait on it before it goes.
+class JobCounter {
+
+public:
+                            JobCounter(): pending { 0 } {}
+                            JobCounter(const JobCounter& other) = delete;
+
+    JobCounter&             operator=(const JobCounter& other) = delete;
+
+    bool                    IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<size_t>     pending;
+};
+
+// Fixed set of workers, each with its own work stealing deque. Jobs started on
+// a worker go to its deque and run newest first there, while idle workers steal
+// the oldest ones. Jobs started on other threads go through a shared queue.
+// Waiting on a counter runs jobs instead of blocking, so a job can wait for the
+// jobs it started, and the waiting thread helps out. Jobs must not throw.
+class JobSystem {
+
+public:
+    // Zero workers is valid, jobs then run on the threads waiting for them
+    explicit                JobSystem(size_t workerCount, bool pinWorkers = false);
+                            JobSystem(const JobSystem& other) = delete;
+    // Runs the jobs still queued on the destroying thread
+                            ~JobSystem();
+
+    JobSystem&              operator=(const JobSystem& other) = delete;
+
+    void                    Run(std::function<void()> job, JobCounter& counter);
+    void                    Wait(JobCounter& counter);
+    // Calls body(first, last) for consecutive chunks of at most grainSize indices, returns when all are done
+    void                    ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+    size_t                  GetWorkerCount() const { return workers.size(); }
+    uint64_t                GetStealCount() const { return steals.load(std::memory_order_relaxed); }
+
+    // One worker less than there are cores, the thread waiting on jobs takes the last one
+    static size_t           GetDefaultWorkerCount();
+
+private:
+    struct Job {
+        std::function<void()>   function;
+        JobCounter*             counter;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Job*, jobDequeCapacity>   deque;
+        std::thread                                 thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>>    workers;
+    std::mutex                              mutex;
+    std::condition_variable                 wake;
+    std::deque<Job*>                        injected;
+    std::atomic<size_t>                     injectedCount;
+    std::atomic<size_t>                     sleeping;
+    std::atomic<bool>                       running;
+    std::atomic<uint64_t>                   steals;
+
+    void                    WorkerLoop(size_t index, bool pin);
+    void                    Sleep();
+    void                    Notify();
+    bool                    HasWork() const;
+    Job*                    FindJob(uint32_t& seed);
+    bool                    TryRunOne(uint32_t& seed);
+    void                    Execute(Job* job);
+    int                     GetCurrentWorker() const;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded single producer, single consumer queue without locks or allocation.
+// Head and tail live on separate cache lines, and each side caches the other's
+// index so the shared lines are only touched when the cached one runs out.
+template<typename T, size_t capacity>
+class SpscRing {
+
+    static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "Ring capacity must be a power of two");
+
+public:
+                            SpscRing();
+
+    // Producer side, false if the ring is full
+    bool                    TryPush(const T& value);
+    // Consumer side, false if the ring is empty
+    bool                    TryPop(T& value);
+    size_t                  GetSizeApprox() const;
+
+private:
+    static const size_t     cacheLineSize = 64;
+    static const size_t     mask = capacity - 1;
+
+    std::atomic<size_t>     tail;
+    size_t                  cachedHead;
+    char                    producerPadding[cacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    std::atomic<size_t>     head;
+    size_t                  cachedTail;
+    char                    consumerPadding[cacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    T                       slots[capacity];
+};
+
+template<typename T, size_t capacity>
+SpscRing<T, capacity>::SpscRing():
+    tail { 0 },
+    cachedHead { 0 },
+    head { 0 },
+    cachedTail { 0 } {
+}
+
+template<typename T, size_t capacity>
+bool SpscRing<T, capacity>::TryPush(const T& value) {
+    size_t current = tail.load(std::memory_order_relaxed);
+
+    if (current - cachedHead == capacity) {
+        cachedHead = head.load(std::memory_order_acquire);
+        if (current - cachedHead == capacity) {
+            return false;
+        }
+    }
+    slots[current & mask] = value;
+    tail.store(current + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, size_t capacity>
+bool SpscRing<T, capacity>::TryPop(T& value) {
+    size_t current = head.load(std::memory_order_relaxed);
+
+    if (current == cachedTail) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        if (current == cachedTail) {
+            return false;
+        }
+    }
+    value = slots[current & mask];
+    head.store(current + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, size_t capacity>
+size_t SpscRing<T, capacity>::GetSizeApprox() const {
+    return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed);
+}
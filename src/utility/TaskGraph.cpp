@@ -0,0 +1,132 @@
+#include "TaskGraph.h"
+
+TaskGraph::TaskGraph():
+    remaining { 0 },
+    duration { 0 } {
+}
+
+TaskGraph::TaskId TaskGraph::Add(const std::string& name, std::function<void()> task, std::initializer_list<TaskId> dependencies) {
+    return AddTask(name, std::move(task), dependencies, false);
+}
+
+TaskGraph::TaskId TaskGraph::AddMainThread(const std::string& name, std::function<void()> task, std::initializer_list<TaskId> dependencies) {
+    return AddTask(name, std::move(task), dependencies, true);
+}
+
+TaskGraph::TaskId TaskGraph::AddTask(const std::string& name, std::function<void()> task, std::initializer_list<TaskId> dependencies, bool mainThread) {
+    TaskId id = tasks.size();
+
+    for (auto dependency: dependencies) {
+        if (dependency >= id) {
+            throw std::runtime_error("Task graph dependency has to be added before its dependent");
+        }
+        tasks[dependency].dependents.push_back(id);
+    }
+    tasks.push_back(Task { name,
+        std::move(task),
+        {},
+        dependencies.size(),
+        dependencies.size(),
+        mainThread,
+        false,
+        std::chrono::nanoseconds { 0 },
+        std::chrono::nanoseconds { 0 } });
+    return id;
+}
+
+std::chrono::nanoseconds TaskGraph::GetRunTime() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - runStart);
+}
+
+void TaskGraph::Run(ThreadPool& pool) {
+    std::unique_lock<std::mutex> lock { mutex };
+
+    runStart = std::chrono::steady_clock::now();
+    remaining = tasks.size();
+    error = nullptr;
+    mainQueue.clear();
+    for (auto& task: tasks) {
+        task.pending = task.dependencyCount;
+        task.skipped = false;
+    }
+    for (TaskId id = 0; id < tasks.size(); id++) {
+        if (tasks[id].pending == 0) {
+            Dispatch(id, pool);
+        }
+    }
+
+    while (true) {
+        mainTaskReady.wait(lock, [this]() { return !mainQueue.empty() || remaining == 0; });
+        if (mainQueue.empty()) {
+            break;
+        }
+        TaskId id = mainQueue.front();
+        mainQueue.pop_front();
+
+        lock.unlock();
+        Execute(id, pool);
+        lock.lock();
+    }
+    duration = GetRunTime();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Called with the mutex held
+void TaskGraph::Dispatch(TaskId id, ThreadPool& pool) {
+    if (tasks[id].mainThread) {
+        mainQueue.push_back(id);
+        mainTaskReady.notify_one();
+    } else {
+        pool.Enqueue([this, id, &pool]() { Execute(id, pool); });
+    }
+}
+
+void TaskGraph::Execute(TaskId id, ThreadPool& pool) {
+    Task& task = tasks[id];
+    std::exception_ptr taskError;
+    bool skip;
+
+    {
+        std::lock_guard<std::mutex> lock { mutex };
+        skip = error != nullptr;
+    }
+    task.start = GetRunTime();
+    if (!skip) {
+        try {
+            task.function();
+        }
+        catch (...) {
+            taskError = std::current_exception();
+        }
+    }
+    task.end = GetRunTime();
+
+    std::lock_guard<std::mutex> lock { mutex };
+    task.skipped = skip;
+    if (taskError && !error) {
+        error = taskError;
+    }
+    for (auto dependent: task.dependents) {
+        if (--tasks[dependent].pending == 0) {
+            Dispatch(dependent, pool);
+        }
+    }
+    if (--remaining == 0) {
+        mainTaskReady.notify_all();
+    }
+}
+
+std::vector<TaskTiming> TaskGraph::GetTimings() const {
+    std::lock_guard<std::mutex> lock { mutex };
+    std::vector<TaskTiming> timings;
+
+    for (const auto& task: tasks) {
+        if (!task.skipped) {
+            timings.push_back(TaskTiming { task.name, task.start, task.end });
+        }
+    }
+    return timings;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+
+#include "ThreadPool.h"
+
+struct TaskTiming {
+    std::string                 name;
+    // relative to the start of Run
+    std::chrono::nanoseconds    start;
+    std::chrono::nanoseconds    end;
+};
+
+// Tasks with dependencies, each started on the pool as soon as everything it
+// depends on has finished. Dependencies have to be added first, so the graph
+// can not have cycles. Main thread tasks run on the thread calling Run.
+class TaskGraph {
+
+public:
+    typedef size_t          TaskId;
+
+                            TaskGraph();
+                            TaskGraph(const TaskGraph& other) = delete;
+
+    TaskGraph&              operator=(const TaskGraph& other) = delete;
+
+    TaskId                  Add(const std::string& name, std::function<void()> task, std::initializer_list<TaskId> dependencies = {});
+    TaskId                  AddMainThread(const std::string& name, std::function<void()> task, std::initializer_list<TaskId> dependencies = {});
+    // Returns once every task is done. After a task throws, the ones not started yet
+    // are skipped and the first exception is rethrown here.
+    void                    Run(ThreadPool& pool);
+
+    std::vector<TaskTiming> GetTimings() const;
+    std::chrono::nanoseconds GetDuration() const { return duration; }
+
+private:
+    struct Task {
+        std::string                 name;
+        std::function<void()>       function;
+        std::vector<TaskId>         dependents;
+        size_t                      dependencyCount;
+        size_t                      pending;
+        bool                        mainThread;
+        bool                        skipped;
+        std::chrono::nanoseconds    start;
+        std::chrono::nanoseconds    end;
+    };
+
+    std::vector<Task>                   tasks;
+    mutable std::mutex                  mutex;
+    std::condition_variable             mainTaskReady;
+    std::deque<TaskId>                  mainQueue;
+    size_t                              remaining;
+    std::exception_ptr                  error;
+    std::chrono::steady_clock::time_point   runStart;
+    std::chrono::nanoseconds            duration;
+
+    TaskId                  AddTask(const std::string& name, std::function<void()> task, std::initializer_list<TaskId> dependencies, bool mainThread);
+    void                    Dispatch(TaskId id, ThreadPool& pool);
+    void                    Execute(TaskId id, ThreadPool& pool);
+    std::chrono::nanoseconds    GetRunTime() const;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// On disk layout of a texture with its full mip chain:
+//   header | mip table (one entry per level, level 0 is the full size) | level data...
+// Level data is stored smallest level first, so the mip tail is one
+// contiguous read at the start of the data. Levels start on 16 byte boundaries.
+
+const char          textureFileMagic[8] = { 'T', 'V', 'T', 'E', 'X', 0, 0, 0 };
+const uint32_t      textureFileVersion = 1;
+const uint32_t      maxTextureFileMips = 16;
+const size_t        textureFileAlignment = 16;
+
+enum class TextureFileFormat: uint32_t {
+    RGBA8_UNORM = 1,
+    RGBA8_SRGB = 2
+};
+
+struct TextureFileHeader {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    format;
+    uint32_t    width;
+    uint32_t    height;
+    uint32_t    mipCount;
+    uint32_t    reserved;
+};
+
+struct TextureFileMip {
+    uint64_t    offset;
+    uint64_t    size;
+    uint32_t    width;
+    uint32_t    height;
+};
+
+static_assert(sizeof(TextureFileHeader) == 32, "Unexpected texture header size");
+static_assert(sizeof(TextureFileMip) == 24, "Unexpected texture mip size");
+
+// Large enough for the header and the mip table of any texture
+const size_t textureFileHeaderReadSize = sizeof(TextureFileHeader) + maxTextureFileMips * sizeof(TextureFileMip);
+
+inline uint32_t GetTextureFileTexelSize(TextureFileFormat) {
+    return 4;
+}
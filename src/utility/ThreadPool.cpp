@@ -0,0 +1,62 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount):
+    activeCount { 0 },
+    running { true } {
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::Run, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock { mutex };
+        running = false;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::GetDefaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ThreadPool::Enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock { mutex };
+        tasks.push_back(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::WaitIdle() {
+    std::unique_lock<std::mutex> lock { mutex };
+    idle.wait(lock, [this]() { return tasks.empty() && activeCount == 0; });
+}
+
+void ThreadPool::Run() {
+    std::unique_lock<std::mutex> lock { mutex };
+
+    while (true) {
+        taskAvailable.wait(lock, [this]() { return !tasks.empty() || !running; });
+        if (tasks.empty()) {
+            return;
+        }
+        std::function<void()> task { std::move(tasks.front()) };
+        tasks.pop_front();
+        activeCount++;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        activeCount--;
+        if (tasks.empty() && activeCount == 0) {
+            idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+// Fixed set of worker threads running queued tasks in FIFO order.
+// The destructor finishes every task queued up to that point.
+class ThreadPool {
+
+public:
+    explicit                ThreadPool(size_t threadCount);
+                            ThreadPool(const ThreadPool& other) = delete;
+                            ~ThreadPool();
+
+    ThreadPool&             operator=(const ThreadPool& other) = delete;
+
+    void                    Enqueue(std::function<void()> task);
+    void                    WaitIdle();
+    size_t                  GetThreadCount() const { return workers.size(); }
+
+    static size_t           GetDefaultThreadCount();
+
+private:
+    std::mutex                          mutex;
+    std::condition_variable             taskAvailable;
+    std::condition_variable             idle;
+    std::deque<std::function<void()>>   tasks;
+    size_t                              activeCount;
+    bool                                running;
+    std::vector<std::thread>            workers;
+
+    void                    Run();
+};
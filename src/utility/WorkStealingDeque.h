@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Bounded Chase-Lev deque. The owning thread pushes and pops at the bottom,
+// any other thread steals from the top, and only a pop of the last item races
+// a steal for it. T has to be cheap to copy, usually a pointer.
+template<typename T, size_t capacity>
+class WorkStealingDeque {
+
+    static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "Deque capacity must be a power of two");
+
+public:
+                            WorkStealingDeque();
+
+    // Owner side, false if the deque is full
+    bool                    TryPush(T value);
+    // Owner side, newest item first
+    bool                    TryPop(T& value);
+    // Any thread, oldest item first. False if empty or another thread got the item.
+    bool                    TrySteal(T& value);
+    size_t                  GetSizeApprox() const;
+
+private:
+    static const size_t     cacheLineSize = 64;
+    static const int64_t    mask = static_cast<int64_t>(capacity) - 1;
+
+    std::atomic<int64_t>    top;
+    char                    topPadding[cacheLineSize - sizeof(std::atomic<int64_t>)];
+    std::atomic<int64_t>    bottom;
+    char                    bottomPadding[cacheLineSize - sizeof(std::atomic<int64_t>)];
+    std::atomic<T>          slots[capacity];
+};
+
+template<typename T, size_t capacity>
+WorkStealingDeque<T, capacity>::WorkStealingDeque():
+    top { 0 },
+    bottom { 0 } {
+}
+
+template<typename T, size_t capacity>
+bool WorkStealingDeque<T, capacity>::TryPush(T value) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+
+    if (b - t >= static_cast<int64_t>(capacity)) {
+        return false;
+    }
+    slots[b & mask].store(value, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, size_t capacity>
+bool WorkStealingDeque<T, capacity>::TryPop(T& value) {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+
+    // claim the bottom item before looking at top, thieves see the smaller bottom from here on
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+    value = slots[b & mask].load(std::memory_order_relaxed);
+    if (t < b) {
+        return true;
+    }
+    // the last item, whoever moves top first gets it
+    bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template<typename T, size_t capacity>
+bool WorkStealingDeque<T, capacity>::TrySteal(T& value) {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return false;
+    }
+    value = slots[t & mask].load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+template<typename T, size_t capacity>
+size_t WorkStealingDeque<T, capacity>::GetSizeApprox() const {
+    int64_t size = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+
+#include "logging/BinaryLogger.h"
+#include "Decoder.h"
+
+// Writes records through a registered format id and through the plain string
+// path, then decodes the file again. Exits with the number of failures.
+
+using namespace logging;
+
+static const char* const logFilename = "binary-log-test.blog";
+
+static int failures = 0;
+
+static void Expect(const char* what, const std::string& actual, const std::string& expected) {
+    if (actual != expected) {
+        printf("FAIL %-16s got \"%s\", expected \"%s\"\n", what, actual.c_str(), expected.c_str());
+        failures++;
+    }
+}
+
+// Everything after the "[date] " prefix
+static std::string StripTimestamp(const std::string& line) {
+    size_t end = line.find("] ");
+    return end != std::string::npos ? line.substr(end + 2) : line;
+}
+
+int main() {
+    {
+        BinaryLogger logger { LogLevel::DEBUG, logFilename, 1024 * 1024 };
+        uint32_t formatId = logger.RegisterFormat(LogLevel::INFO, "%s has %u textures, %x %d %.2f", __FILE__, __LINE__);
+
+        logger.WriteRecord(LogLevel::INFO, formatId, std::string("window"), 12u, -1, -1, 0.125);
+        logger.WriteRecord(LogLevel::WARN, formatId, "other", 0u, 255, 7ll, 2.5);
+        logger.Write(LogLevel::ERROR, "plain message");
+    }
+
+    std::ifstream file { logFilename, std::ios::binary };
+    std::vector<uint8_t> data { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    std::ostringstream text;
+    BinaryLogCounts counts { DecodeBinaryLog(data.data(), data.size(), text) };
+    std::istringstream lines { text.str() };
+    std::string line;
+
+    std::getline(lines, line);
+    Expect("format id", StripTimestamp(line), "INFO - window has 12 textures, ffffffff -1 0.12");
+    std::getline(lines, line);
+    Expect("same format id", StripTimestamp(line), "WARN - other has 0 textures, ff 7 2.50");
+    std::getline(lines, line);
+    Expect("string record", StripTimestamp(line), "ERROR - plain message");
+    if (counts.messages != 3) {
+        printf("FAIL decoded %zu messages, expected 3\n", counts.messages);
+        failures++;
+    }
+    std::remove(logFilename);
+
+    printf("%s, %d failures\n", failures == 0 ? "passed" : "failed", failures);
+    return failures;
+}
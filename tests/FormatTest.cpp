@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <climits>
+#include <string>
+#include <algorithm>
+
+#include "utility/Format.h"
+
+// Checks FORMAT and FORMAT_TO against snprintf. Exits with the number of failures.
+
+static int failures = 0;
+
+static void Expect(const char* what, const std::string& actual, const std::string& expected) {
+    if (actual != expected) {
+        printf("FAIL %-24s got \"%s\", expected \"%s\"\n", what, actual.c_str(), expected.c_str());
+        failures++;
+    }
+}
+
+// Format strings vary per case here, so this goes through Format without the compile time check
+template<typename... Args>
+static void Compare(const char* format, const Args&... args) {
+    char expected[512];
+    char truncated[8];
+
+    int length = snprintf(expected, sizeof(expected), format, args...);
+    Expect(format, Format(format, args...), expected);
+
+    // snprintf into the small buffer would keep the same prefix
+    size_t truncatedLength = FormatTo(truncated, sizeof(truncated), format, args...);
+    Expect(format, truncated, std::string(expected, std::min<size_t>(length, sizeof(truncated) - 1)));
+    if (truncatedLength != static_cast<size_t>(length)) {
+        printf("FAIL %-24s FormatTo returned %zu, expected %d\n", format, truncatedLength, length);
+        failures++;
+    }
+}
+
+int main() {
+    Compare("%d %i", 42, -42);
+    Compare("%d", INT_MIN);
+    Compare("%lld", LLONG_MIN);
+    Compare("%u %zu", 7u, static_cast<size_t>(123456789));
+    Compare("%x %X %o", -1, -1, -1);
+    Compare("%llx", -1ll);
+    Compare("%x", static_cast<short>(-2));
+    Compare("%c%c", 'o', 'k');
+    Compare("% d|% d", 5, -5);
+    Compare("%+d|%+d", 5, -5);
+    Compare("%05d|%-6d|%6d", -42, 42, 42);
+    Compare("%.3d|%.0d|%8.3d|%08.3d", 7, 0, -7, 7);
+    Compare("%#x|%#X|%#o|%#o|%#x", 255, 255, 8, 0, 0);
+    Compare("%#010x", 255);
+
+    Compare("%f", 3.14159);
+    Compare("%.0f|%.0f|%.0f", 2.5, 3.5, -0.5);
+    Compare("%.1f|%.2f", 0.95, 1.005);
+    Compare("%10.3f|%-10.3f|%010.3f", 3.14159, -3.14159, -3.14159);
+    Compare("%+.2f|% .2f|%#.0f", 1.0, 1.0, 2.0);
+    Compare("%f", 1e20);
+    Compare("%.3f", 1e300);
+    Compare("%f|%F", -0.0, 1.5);
+    Compare("%.17f", 0.1);
+
+    Compare("%s|%10s|%-10s|%.3s", "text", "text", "text", "text");
+
+    // a result passed on to the next call lives in the buffer that call writes to
+    const std::string& inner = FORMAT("%d", 7);
+    Expect("FORMAT of FORMAT", FORMAT("x=%s", inner), "x=7");
+    const char* text = FORMAT("%d", 7).c_str();
+    Expect("FORMAT of c_str", FORMAT("x=%s y=%d", text, 8), "x=7 y=8");
+    Expect("Format of Format", Format("x=%s", Format("%d", 7)), "x=7");
+    Expect("after nesting", FORMAT("%s", "plain"), "plain");
+
+    printf("%s, %d failures\n", failures == 0 ? "passed" : "failed", failures);
+    return failures;
+}
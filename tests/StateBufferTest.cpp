@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <chrono>
+
+#include "engine/FrameState.h"
+#include "engine/StateBuffer.h"
+
+// Checks that input times survive frame states the render thread never acquired.
+// Exits with the number of failures.
+
+using namespace engine;
+using Clock = std::chrono::steady_clock;
+
+static int failures = 0;
+
+static void Expect(const char* what, bool condition) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// Publishes like Engine::DrawFrame does, input time none for a frame without input
+static void Publish(StateBuffer<FrameState>& buffer, uint64_t sequence, Clock::time_point inputTime) {
+    if (inputTime != Clock::time_point {}) {
+        buffer.GetBack().inputTime = inputTime;
+    }
+    buffer.GetBack().sequence = sequence;
+    buffer.Publish();
+    buffer.GetBack().inputTime = {};
+}
+
+int main() {
+    StateBuffer<FrameState> buffer { defaultFrameState };
+    FrameState state;
+    const Clock::time_point none {};
+    const Clock::time_point first = Clock::now();
+    const Clock::time_point second = first + std::chrono::milliseconds(1);
+    const Clock::time_point third = first + std::chrono::milliseconds(2);
+
+    Publish(buffer, 1, first);
+    Publish(buffer, 2, second);
+    Publish(buffer, 3, none);
+    Expect("acquire after three publishes is fresh", buffer.Acquire(state));
+    Expect("latest sequence is acquired", state.sequence == 3);
+    Expect("earliest input time is kept", state.inputTime == first);
+
+    Expect("second acquire is not fresh", !buffer.Acquire(state));
+    Expect("second acquire sees the same input time", state.inputTime == first);
+
+    Publish(buffer, 4, none);
+    Expect("acquire after publish without input", buffer.Acquire(state));
+    Expect("consumed input time is not carried over", state.inputTime == none);
+
+    Publish(buffer, 5, none);
+    Publish(buffer, 6, third);
+    Publish(buffer, 7, none);
+    buffer.Acquire(state);
+    Expect("input after a publish without input is kept", state.inputTime == third);
+
+    Publish(buffer, 8, second);
+    buffer.Acquire(state);
+    Publish(buffer, 9, third);
+    buffer.Acquire(state);
+    Expect("input time of the acquired state only", state.inputTime == third);
+
+    printf("%s, %d failures\n", failures == 0 ? "passed" : "failed", failures);
+    return failures;
+}
@@ -0,0 +1,207 @@
+#include "Decoder.h"
+
+namespace logging {
+
+struct FormatEntry {
+    std::string     format;
+    std::string     file;
+    uint32_t        line;
+};
+
+class ArgReader {
+
+public:
+                    ArgReader(const uint8_t* data_, size_t size_):
+                        data { data_ },
+                        size { size_ },
+                        pos { 0 } {
+                    }
+
+    bool            Next(BinaryArgTag& tag, uint64_t& value, const char*& str, uint32_t& length) {
+        if (pos >= size) {
+            return false;
+        }
+        tag = static_cast<BinaryArgTag>(data[pos++]);
+        if (tag == BinaryArgTag::STRING) {
+            if (pos + sizeof(length) > size) {
+                return false;
+            }
+            std::memcpy(&length, data + pos, sizeof(length));
+            pos += sizeof(length);
+            if (pos + length > size) {
+                return false;
+            }
+            str = reinterpret_cast<const char*>(data + pos);
+            pos += length;
+        } else {
+            if (pos + sizeof(value) > size) {
+                return false;
+            }
+            std::memcpy(&value, data + pos, sizeof(value));
+            pos += sizeof(value);
+        }
+        return true;
+    }
+
+private:
+    const uint8_t*  data;
+    size_t          size;
+    size_t          pos;
+};
+
+static void AppendArg(formatting::FormatBuffer& out, const formatting::FormatSpec& spec, ArgReader& args) {
+    BinaryArgTag tag;
+    uint64_t value = 0;
+    const char* str = nullptr;
+    uint32_t length = 0;
+
+    if (!args.Next(tag, value, str, length)) {
+        out.Append("<missing>", 9);
+        return;
+    }
+    switch (tag) {
+        case BinaryArgTag::SIGNED:
+        case BinaryArgTag::SIGNED32:
+            if (spec.conversion == 'c') {
+                char c = static_cast<char>(value);
+                formatting::FormatString(out, spec, &c, 1);
+            } else if (tag == BinaryArgTag::SIGNED32 && spec.conversion != 'd' && spec.conversion != 'i') {
+                formatting::FormatUnsigned(out, spec, static_cast<uint32_t>(value));
+            } else {
+                formatting::FormatSigned(out, spec, static_cast<int64_t>(value));
+            }
+            break;
+        case BinaryArgTag::UNSIGNED:
+            if (spec.conversion == 'c') {
+                char c = static_cast<char>(value);
+                formatting::FormatString(out, spec, &c, 1);
+            } else {
+                formatting::FormatUnsigned(out, spec, value);
+            }
+            break;
+        case BinaryArgTag::BOOL:
+            if (spec.conversion == 's') {
+                formatting::FormatString(out, spec, value ? "true" : "false", value ? 4 : 5);
+            } else {
+                formatting::FormatUnsigned(out, spec, value);
+            }
+            break;
+        case BinaryArgTag::FLOAT: {
+            double d;
+            std::memcpy(&d, &value, sizeof(d));
+            formatting::FormatFloat(out, spec, d);
+            break;
+        }
+        case BinaryArgTag::STRING:
+            formatting::FormatString(out, spec, str, length);
+            break;
+        case BinaryArgTag::POINTER:
+            formatting::FormatPointer(out, spec, reinterpret_cast<const void*>(static_cast<uintptr_t>(value)));
+            break;
+        default:
+            out.Append("<bad arg>", 9);
+            break;
+    }
+}
+
+static std::string FormatRecord(const FormatEntry& entry, ArgReader args) {
+    std::string text;
+    formatting::FormatBuffer out { text };
+    const char* format = entry.format.c_str();
+
+    for (;;) {
+        formatting::FormatSpec spec {};
+
+        format = formatting::AppendLiteral(out, format);
+        if (*format == 0) {
+            break;
+        }
+        format = formatting::ParseSpec(format, spec);
+        AppendArg(out, spec, args);
+    }
+    return text;
+}
+
+static std::string FormatTimestamp(const BinaryLogHeader& header, int64_t ticks) {
+    // ticks * num / den seconds, kept in ns to stay in range
+    long double elapsedNs = static_cast<long double>(ticks - header.startTicks) * header.tickNum * 1e9L / header.tickDen;
+    time_t rawTime = static_cast<time_t>((header.startWallNs + static_cast<int64_t>(elapsedNs)) / 1000000000LL);
+    struct tm localTime;
+    char buffer[32];
+
+    #ifdef _WIN32
+    localtime_s(&localTime, &rawTime);
+    #endif
+    #ifdef __linux__
+    localtime_r(&rawTime, &localTime);
+    #endif
+
+    FormatTo(buffer, sizeof(buffer), "[%04d-%02d-%02d %02d:%02d:%02d]",
+        localTime.tm_year + 1900,
+        localTime.tm_mon + 1,
+        localTime.tm_mday,
+        localTime.tm_hour,
+        localTime.tm_min,
+        localTime.tm_sec);
+    return buffer;
+}
+
+BinaryLogCounts DecodeBinaryLog(const uint8_t* data, size_t size, std::ostream& out) {
+    BinaryLogHeader header;
+
+    if (size < sizeof(header)) {
+        throw std::runtime_error("File too small for a binary log header");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, binaryLogMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a binary log file");
+    }
+    // version 1 files only lack the 32 bit signed tag
+    if (header.version == 0 || header.version > binaryLogVersion) {
+        throw std::runtime_error("Unsupported binary log version " + std::to_string(header.version));
+    }
+
+    std::unordered_map<uint32_t, FormatEntry> formats;
+    size_t pos = header.headerSize;
+    size_t messages = 0;
+
+    while (pos + sizeof(BinaryRecordHeader) <= size) {
+        BinaryRecordHeader record;
+        std::memcpy(&record, data + pos, sizeof(record));
+
+        if (record.size == 0 || pos + record.size > size) {
+            break;
+        }
+        const uint8_t* base = data + pos;
+
+        if (record.type == static_cast<uint16_t>(BinaryRecordType::FORMAT)) {
+            BinaryFormatRecord formatRecord;
+            std::memcpy(&formatRecord, base, sizeof(formatRecord));
+            const char* strings = reinterpret_cast<const char*>(base + sizeof(formatRecord));
+
+            formats[formatRecord.formatId] = FormatEntry {
+                std::string(strings + formatRecord.fileLength, formatRecord.formatLength),
+                std::string(strings, formatRecord.fileLength),
+                formatRecord.line
+            };
+        } else if (record.type == static_cast<uint16_t>(BinaryRecordType::MESSAGE)) {
+            BinaryMessageRecord message;
+            std::memcpy(&message, base, sizeof(message));
+            auto entry = formats.find(message.formatId);
+
+            out << FormatTimestamp(header, message.ticks) << " "
+                << GetLevelName(static_cast<LogLevel>(record.level)) << " - ";
+            if (entry != formats.end()) {
+                out << FormatRecord(entry->second, ArgReader { base + sizeof(message), message.argSize });
+            } else {
+                out << "<unknown format " << message.formatId << ">";
+            }
+            out << '\n';
+            messages++;
+        }
+        pos += record.size;
+    }
+    return BinaryLogCounts { messages, formats.size() };
+}
+
+}
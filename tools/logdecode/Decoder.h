@@ -0,0 +1,24 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <ctime>
+#include <unordered_map>
+#include <stdexcept>
+
+#include "logging/Logger.h"
+#include "logging/BinaryLogFormat.h"
+#include "utility/Format.h"
+
+namespace logging {
+
+struct BinaryLogCounts {
+    size_t          messages;
+    size_t          formats;
+};
+
+// Writes every message in a binary log as a text log line, throws if data is not a binary log
+BinaryLogCounts DecodeBinaryLog(const uint8_t* data, size_t size, std::ostream& out);
+
+}
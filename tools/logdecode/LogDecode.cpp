@@ -0,0 +1,40 @@
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+
+#include "utility/File.h"
+#include "Decoder.h"
+
+// Turns a binary log written by logging::BinaryLogger back into the
+// "[date] LEVEL - msg" lines the text loggers produce.
+// Usage: logdecode <file.blog> [output.log]
+
+using namespace logging;
+
+static void Decode(const MappedFile& data, std::ostream& out) {
+    BinaryLogCounts counts { DecodeBinaryLog(data.GetData(), data.GetSize(), out) };
+
+    std::cerr << "Decoded " << counts.messages << " messages, " << counts.formats << " formats" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <file.blog> [output.log]" << std::endl;
+        return 1;
+    }
+    try {
+        MappedFile data { argv[1], AccessHint::SEQUENTIAL };
+
+        if (argc > 2) {
+            std::ofstream out { argv[2] };
+            Decode(data, out);
+        } else {
+            Decode(data, std::cout);
+        }
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+
+#include "utility/TextureFileFormat.h"
+#include "utility/File.h"
+
+// Builds a streamable texture from raw RGBA8 pixels, box filtering every
+// mip level down to 1x1.
+// Usage: mipgen [--srgb] <width> <height> <input.rgba> <output.tvtex>
+
+using MipLevel = std::vector<uint8_t>;
+
+static MipLevel Downsample(const MipLevel& src, uint32_t width, uint32_t height, uint32_t newWidth, uint32_t newHeight) {
+    MipLevel dst(size_t(newWidth) * newHeight * 4);
+
+    for (uint32_t y = 0; y < newHeight; y++) {
+        for (uint32_t x = 0; x < newWidth; x++) {
+            uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+            uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+
+            for (uint32_t c = 0; c < 4; c++) {
+                uint32_t sum = src[(size_t(y0) * width + x0) * 4 + c] +
+                    src[(size_t(y0) * width + x1) * 4 + c] +
+                    src[(size_t(y1) * width + x0) * 4 + c] +
+                    src[(size_t(y1) * width + x1) * 4 + c];
+                dst[(size_t(y) * newWidth + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static void Generate(uint32_t width, uint32_t height, bool srgb, const std::string& input, const std::string& output) {
+    MappedFile source { input, AccessHint::SEQUENTIAL };
+    std::vector<MipLevel> levels;
+    std::vector<TextureFileMip> mips;
+    TextureFileHeader header {};
+
+    if (source.GetSize() != size_t(width) * height * 4) {
+        throw std::runtime_error("Input size does not match " + std::to_string(width) + "x" + std::to_string(height) + " RGBA8");
+    }
+    levels.emplace_back(source.GetData(), source.GetData() + source.GetSize());
+    mips.push_back(TextureFileMip { 0, levels.back().size(), width, height });
+
+    while ((mips.back().width > 1 || mips.back().height > 1) && mips.size() < maxTextureFileMips) {
+        const TextureFileMip& last = mips.back();
+        uint32_t newWidth = std::max(1u, last.width / 2);
+        uint32_t newHeight = std::max(1u, last.height / 2);
+
+        levels.push_back(Downsample(levels.back(), last.width, last.height, newWidth, newHeight));
+        mips.push_back(TextureFileMip { 0, levels.back().size(), newWidth, newHeight });
+    }
+
+    std::memcpy(header.magic, textureFileMagic, sizeof(header.magic));
+    header.version = textureFileVersion;
+    header.format = static_cast<uint32_t>(srgb ? TextureFileFormat::RGBA8_SRGB : TextureFileFormat::RGBA8_UNORM);
+    header.width = width;
+    header.height = height;
+    header.mipCount = static_cast<uint32_t>(mips.size());
+
+    // smallest level first
+    uint64_t offset = sizeof(TextureFileHeader) + mips.size() * sizeof(TextureFileMip);
+    for (size_t i = mips.size(); i-- > 0;) {
+        offset = AlignUp(offset, textureFileAlignment);
+        mips[i].offset = offset;
+        offset += mips[i].size;
+    }
+
+    std::ofstream out { output, std::ios::binary | std::ios::trunc };
+    static const char zeros[textureFileAlignment] {};
+    uint64_t pos = sizeof(TextureFileHeader) + mips.size() * sizeof(TextureFileMip);
+
+    if (!out.is_open()) {
+        throw std::runtime_error("Could not open output file " + output);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(mips.data()), mips.size() * sizeof(TextureFileMip));
+    for (size_t i = mips.size(); i-- > 0;) {
+        out.write(zeros, mips[i].offset - pos);
+        out.write(reinterpret_cast<const char*>(levels[i].data()), levels[i].size());
+        pos = mips[i].offset + mips[i].size;
+    }
+    if (!out.good()) {
+        throw std::runtime_error("Could not write output file " + output);
+    }
+    std::cout << output << ": " << width << "x" << height << ", " << mips.size() << " levels" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args;
+    bool srgb = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--srgb") == 0) {
+            srgb = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    if (args.size() != 4) {
+        std::cerr << "Usage: " << argv[0] << " [--srgb] <width> <height> <input.rgba> <output.tvtex>" << std::endl;
+        return 1;
+    }
+    try {
+        uint32_t width = static_cast<uint32_t>(std::stoul(args[0]));
+        uint32_t height = static_cast<uint32_t>(std::stoul(args[1]));
+
+        if (width == 0 || height == 0) {
+            throw std::runtime_error("Texture size must not be zero");
+        }
+        Generate(width, height, srgb, args[2], args[3]);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
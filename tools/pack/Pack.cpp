@@ -0,0 +1,185 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <stdexcept>
+
+#include "utility/AssetArchiveFormat.h"
+#include "utility/Compression.h"
+#include "utility/File.h"
+#include "utility/Format.h"
+
+// Packs files into an asset archive for utility/AssetArchive.
+// Usage: pack [--store] <output.pack> <file | name=file>...
+// Entries are named after the file name unless given explicitly. Entries
+// are compressed when that saves at least an eighth, --store disables it.
+
+struct PackInput {
+    std::string             name;
+    std::string             path;
+};
+
+struct PackedEntry {
+    AssetArchiveEntry       entry;
+    std::vector<uint8_t>    compressed;
+    MappedFile              source;
+};
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static PackInput ParseInput(const std::string& arg) {
+    size_t separator = arg.find('=');
+
+    if (separator != std::string::npos) {
+        return PackInput { arg.substr(0, separator), arg.substr(separator + 1) };
+    }
+    size_t slash = arg.find_last_of("/\\");
+    return PackInput { slash == std::string::npos ? arg : arg.substr(slash + 1), arg };
+}
+
+static uint32_t GetSlotCount(size_t entryCount) {
+    uint32_t count = 4;
+
+    // at most half full, keeps probe sequences short
+    while (count < entryCount * 2) {
+        count *= 2;
+    }
+    return count;
+}
+
+static void WritePadding(std::ofstream& out, uint64_t& pos, uint64_t target) {
+    static const char zeros[assetArchiveAlignment] {};
+
+    out.write(zeros, target - pos);
+    pos = target;
+}
+
+static void Pack(const std::string& output, const std::vector<PackInput>& inputs, bool compress) {
+    std::vector<PackedEntry> packed;
+    std::string nameTable;
+    AssetArchiveHeader header {};
+
+    packed.reserve(inputs.size());
+    for (auto& input: inputs) {
+        PackedEntry current { AssetArchiveEntry {}, {}, MappedFile { input.path, AccessHint::SEQUENTIAL } };
+        AssetArchiveEntry& entry = current.entry;
+
+        entry.nameHash = HashAssetName(input.name.data(), input.name.size());
+        entry.nameOffset = static_cast<uint32_t>(nameTable.size());
+        entry.nameLength = static_cast<uint32_t>(input.name.size());
+        entry.size = current.source.GetSize();
+        entry.storedSize = entry.size;
+        entry.compression = static_cast<uint32_t>(AssetCompression::NONE);
+        nameTable += input.name;
+
+        for (auto& other: packed) {
+            if (other.entry.nameHash == entry.nameHash &&
+                nameTable.compare(other.entry.nameOffset, other.entry.nameLength, input.name) == 0) {
+                throw std::runtime_error("Duplicate asset name " + input.name);
+            }
+        }
+
+        if (compress && entry.size > 0) {
+            current.compressed = CompressBlock(current.source.GetData(), current.source.GetSize());
+            if (current.compressed.size() <= entry.size - entry.size / 8) {
+                entry.storedSize = current.compressed.size();
+                entry.compression = static_cast<uint32_t>(AssetCompression::LZ);
+            } else {
+                current.compressed.clear();
+            }
+        }
+        packed.push_back(std::move(current));
+    }
+
+    std::memcpy(header.magic, assetArchiveMagic, sizeof(header.magic));
+    header.version = assetArchiveVersion;
+    header.entryCount = static_cast<uint32_t>(packed.size());
+    header.slotCount = GetSlotCount(packed.size());
+    header.nameTableSize = static_cast<uint32_t>(nameTable.size());
+    header.entryTableOffset = sizeof(AssetArchiveHeader);
+    header.slotTableOffset = header.entryTableOffset + packed.size() * sizeof(AssetArchiveEntry);
+    header.nameTableOffset = header.slotTableOffset + header.slotCount * sizeof(uint32_t);
+
+    std::vector<uint32_t> slots(header.slotCount, 0);
+    uint64_t dataOffset = header.nameTableOffset + header.nameTableSize;
+
+    for (size_t i = 0; i < packed.size(); i++) {
+        AssetArchiveEntry& entry = packed[i].entry;
+        uint32_t mask = header.slotCount - 1;
+        uint32_t slot = entry.nameHash & mask;
+
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<uint32_t>(i + 1);
+
+        dataOffset = AlignUp(dataOffset, assetArchiveAlignment);
+        entry.offset = dataOffset;
+        dataOffset += entry.storedSize;
+    }
+
+    std::ofstream out { output, std::ios::binary | std::ios::trunc };
+    uint64_t pos = 0;
+
+    if (!out.is_open()) {
+        throw std::runtime_error("Could not open output file " + output);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (auto& current: packed) {
+        out.write(reinterpret_cast<const char*>(&current.entry), sizeof(AssetArchiveEntry));
+    }
+    out.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(uint32_t));
+    out.write(nameTable.data(), nameTable.size());
+    pos = header.nameTableOffset + header.nameTableSize;
+
+    for (auto& current: packed) {
+        const AssetArchiveEntry& entry = current.entry;
+
+        WritePadding(out, pos, entry.offset);
+        if (entry.compression == static_cast<uint32_t>(AssetCompression::LZ)) {
+            out.write(reinterpret_cast<const char*>(current.compressed.data()), current.compressed.size());
+        } else {
+            out.write(reinterpret_cast<const char*>(current.source.GetData()), current.source.GetSize());
+        }
+        pos += entry.storedSize;
+        std::cout << Format("%-32s %8llu -> %8llu%s",
+            std::string(nameTable, entry.nameOffset, entry.nameLength),
+            static_cast<unsigned long long>(entry.size),
+            static_cast<unsigned long long>(entry.storedSize),
+            entry.compression != 0 ? " (lz)" : "") << std::endl;
+    }
+    if (!out.good()) {
+        throw std::runtime_error("Could not write output file " + output);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<PackInput> inputs;
+    std::string output;
+    bool compress = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--store") == 0) {
+            compress = false;
+        } else if (output.empty()) {
+            output = argv[i];
+        } else {
+            inputs.push_back(ParseInput(argv[i]));
+        }
+    }
+    if (output.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--store] <output.pack> <file | name=file>..." << std::endl;
+        return 1;
+    }
+    try {
+        Pack(output, inputs, compress);
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}